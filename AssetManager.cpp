@@ -0,0 +1,208 @@
+#include "AssetManager.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <filesystem>
+#include <iostream>
+
+using namespace sf;
+using namespace std;
+
+namespace {
+    const char* const PACK_NAME = "assets.mqas";
+    const char* const FONT_PATH = "Font/ArcadeClassic.ttf";
+    const char* const MUSIC_PATH = "Sound/mazegenerating.wav";
+    const char* const TEXTURE_PATHS[TEXTURE_ASSET_COUNT] = {
+        "Graphics/idle/body/tile000.png", "Graphics/treasure.png", "Graphics/idle/body/tile005.png"
+    };
+    const char* const SOUND_PATHS[SOUND_ASSET_COUNT] = {
+        "Sound/game-start.wav", "Sound/achievement.wav", "Sound/gameOver.wav"
+    };
+    const int JOB_COUNT = TEXTURE_ASSET_COUNT + SOUND_ASSET_COUNT;  // textures first, then sounds
+
+    string environment(const char* name) {
+#ifdef _WIN32
+        char* value = nullptr;
+        size_t length = 0;
+        string result;
+        if (_dupenv_s(&value, &length, name) == 0 && value) {
+            result = value;
+            free(value);
+        }
+        return result;
+#else
+        const char* value = getenv(name);
+        return value ? value : "";
+#endif
+    }
+
+    filesystem::path executablePath(const char* executable) {
+        error_code error;
+        filesystem::path path;
+#ifdef __linux__
+        path = filesystem::read_symlink("/proc/self/exe", error);
+#endif
+        if (path.empty() && executable) {
+            path = filesystem::absolute(executable, error);
+        }
+        return path;
+    }
+}
+
+AssetManager::~AssetManager() {
+    for (thread& worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+}
+
+bool AssetManager::useSource(const string& path) {
+    error_code error;
+    if (filesystem::is_directory(path, error) && filesystem::exists(filesystem::path(path) / FONT_PATH, error)) {
+        source = path;
+        return true;
+    }
+    if (filesystem::is_regular_file(path, error) && pack.open(path)) {
+        source = path;
+        return true;
+    }
+    return false;
+}
+
+bool AssetManager::open(const string& path, const char* executable) {
+    if (!path.empty()) {
+        return useSource(path);
+    }
+    string fromEnvironment = environment("MAZEQUEST_ASSETS");
+    if (!fromEnvironment.empty()) {
+        return useSource(fromEnvironment);
+    }
+
+    // Beside the executable, or up to three folders above it for one still in its build tree
+    // (build/, x64/Release/), then the working directory. A pack wins over loose files.
+    filesystem::path folder = executablePath(executable).parent_path();
+    for (int up = 0; up < 4 && !folder.empty(); ++up) {
+        if (useSource((folder / PACK_NAME).string()) || useSource(folder.string())) {
+            return true;
+        }
+        if (folder == folder.parent_path()) {
+            break;
+        }
+        folder = folder.parent_path();
+    }
+    return useSource(PACK_NAME) || useSource(".");
+}
+
+bool AssetManager::read(const string& name, MappedFile& file, const uint8_t*& data, size_t& size) const {
+    if (pack.isOpen()) {
+        return pack.find(name, data, size);
+    }
+    if (!file.open(source + "/" + name)) {
+        return false;
+    }
+    data = file.data();
+    size = file.size();
+    return true;
+}
+
+void AssetManager::decode(int job) {
+    // Only decoding happens here: nothing touches OpenGL or OpenAL off the main thread.
+    MappedFile file;
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    if (job < TEXTURE_ASSET_COUNT) {
+        decodeFailed[job] = !read(TEXTURE_PATHS[job], file, data, size) || !images[job].loadFromMemory(data, size);
+        return;
+    }
+
+    DecodedSound& sound = decoded[job - TEXTURE_ASSET_COUNT];
+    InputSoundFile input;
+    if (!read(SOUND_PATHS[job - TEXTURE_ASSET_COUNT], file, data, size) || !input.openFromMemory(data, size)) {
+        decodeFailed[job] = true;
+        return;
+    }
+    sound.channels = input.getChannelCount();
+    sound.sampleRate = input.getSampleRate();
+    sound.samples.resize(static_cast<size_t>(input.getSampleCount()));
+    sound.samples.resize(static_cast<size_t>(input.read(sound.samples.data(), sound.samples.size())));
+    decodeFailed[job] = sound.samples.empty();
+}
+
+bool AssetManager::loadFont(Font& font) {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    if (pack.isOpen()) {
+        // Read from the mapping as glyphs are needed, so the font must not outlive the manager
+        return pack.find(FONT_PATH, data, size) && font.loadFromMemory(data, size);
+    }
+    return font.loadFromFile(source + "/" + FONT_PATH);
+}
+
+bool AssetManager::openMusic(Music& music) {
+    const uint8_t* data = nullptr;
+    size_t size = 0;
+    if (pack.isOpen()) {
+        return pack.find(MUSIC_PATH, data, size) && music.openFromMemory(data, size);
+    }
+    return music.openFromFile(source + "/" + MUSIC_PATH);
+}
+
+void AssetManager::startLoading(int threads) {
+    loadClock.restart();
+    int count = max(1, min(threads, JOB_COUNT));
+    for (int i = 0; i < count; ++i) {
+        workers.emplace_back([this]() {
+            for (int job; (job = nextJob++) < JOB_COUNT;) {
+                decode(job);
+                ++jobsDone;
+            }
+        });
+    }
+}
+
+bool AssetManager::update() {
+    if (loaded || workers.empty() || jobsDone < JOB_COUNT) {
+        return false;
+    }
+    for (thread& worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+
+    for (int i = 0; i < TEXTURE_ASSET_COUNT; ++i) {
+        if (decodeFailed[i] || !textures[i].loadFromImage(images[i])) {
+            cerr << "Failed to load " << TEXTURE_PATHS[i] << " from " << source << endl;
+        }
+        images[i] = Image();
+    }
+    for (int i = 0; i < SOUND_ASSET_COUNT; ++i) {
+        const DecodedSound& sound = decoded[i];
+        if (decodeFailed[TEXTURE_ASSET_COUNT + i]
+            || !sounds[i].loadFromSamples(sound.samples.data(), sound.samples.size(), sound.channels, sound.sampleRate)) {
+            cerr << "Failed to load " << SOUND_PATHS[i] << " from " << source << endl;
+        }
+        decoded[i] = DecodedSound();
+    }
+    loaded = true;
+    loadTime = loadClock.getElapsedTime();
+    return true;
+}
+
+bool AssetManager::finishLoading() {
+    for (thread& worker : workers) {
+        if (worker.joinable()) {
+            worker.join();
+        }
+    }
+    return update();
+}
+
+size_t AssetManager::soundBytes() const {
+    size_t bytes = 0;
+    for (const SoundBuffer& sound : sounds) {
+        bytes += static_cast<size_t>(sound.getSampleCount()) * sizeof(Int16);
+    }
+    return bytes;
+}
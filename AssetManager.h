@@ -0,0 +1,92 @@
+#pragma once
+
+#include <SFML/Audio.hpp>
+#include <SFML/Graphics.hpp>
+
+#include "MazeCore/AssetPack.h"
+
+#include <atomic>
+#include <cstddef>
+#include <string>
+#include <thread>
+#include <vector>
+
+enum class TextureAsset { Player, Treasure, Visited };
+const int TEXTURE_ASSET_COUNT = 3;
+
+enum class SoundAsset { GameStart, Treasure, GameOver };
+const int SOUND_ASSET_COUNT = 3;
+
+// Finds the game's fonts, images and sounds and loads them. They come from an asset pack
+// (MazeCore/AssetPack.h) or from the Font, Graphics and Sound folders, looked for beside the
+// executable and a few folders above it (so a build directory finds the source tree's), then
+// in the working directory. MAZEQUEST_ASSETS, or --assets, names a folder or pack to use instead.
+//
+// Only the font is loaded up front, since the menu needs it for its first frame. Images and
+// sound effects are read and decoded on worker threads meanwhile, and update() hands them to
+// SFML on the main thread once they are all done. Background music is never decoded whole:
+// openMusic() streams it.
+class AssetManager {
+private:
+    struct DecodedSound {
+        std::vector<sf::Int16> samples;
+        unsigned channels = 0, sampleRate = 0;
+    };
+
+    std::string source;  // the pack, or the folder holding Font, Graphics and Sound
+    AssetPack pack;
+
+    // Written by the workers, read by update() once jobsDone says they are finished
+    sf::Image images[TEXTURE_ASSET_COUNT];
+    DecodedSound decoded[SOUND_ASSET_COUNT];
+    bool decodeFailed[TEXTURE_ASSET_COUNT + SOUND_ASSET_COUNT] = {};
+    std::vector<std::thread> workers;
+    std::atomic<int> nextJob{ 0 }, jobsDone{ 0 };
+
+    sf::Texture textures[TEXTURE_ASSET_COUNT];
+    sf::SoundBuffer sounds[SOUND_ASSET_COUNT];
+    bool loaded = false;
+    sf::Clock loadClock;
+    sf::Time loadTime;
+
+    bool useSource(const std::string& path);
+    bool read(const std::string& name, MappedFile& file, const uint8_t*& data, size_t& size) const;
+    void decode(int job);
+
+public:
+    AssetManager() = default;
+    ~AssetManager();
+    AssetManager(const AssetManager&) = delete;
+    AssetManager& operator=(const AssetManager&) = delete;
+
+    // Picks where assets come from. path, when not empty, is the folder or pack to use;
+    // executable is argv[0]. Returns false if no assets can be found.
+    bool open(const std::string& path, const char* executable);
+    const std::string& getSource() const { return source; }
+
+    // The font is loaded here and now. Music is opened for streaming, a second or so of it
+    // decoded at a time. From a pack, both read the mapped pack and must not outlive the manager.
+    bool loadFont(sf::Font& font);
+    bool openMusic(sf::Music& music);
+
+    // Starts decoding the images and sound effects on up to threads worker threads.
+    void startLoading(int threads);
+
+    // Main thread: once the workers are done, turns their results into textures and sound
+    // buffers. Returns true on the call that does so, and false before and after.
+    bool update();
+
+    // Waits for the workers, then update()s. Returns whether this call did the update.
+    bool finishLoading();
+
+    bool isLoaded() const { return loaded; }
+    sf::Time getLoadTime() const { return loadTime; }
+
+    // Blank until loaded, or if the asset failed to load (which update() reports).
+    const sf::Texture& texture(TextureAsset asset) const { return textures[static_cast<int>(asset)]; }
+    const sf::SoundBuffer& sound(SoundAsset asset) const { return sounds[static_cast<int>(asset)]; }
+    bool hasTexture(TextureAsset asset) const { return texture(asset).getSize().x > 0; }
+
+    // Bytes of decoded samples held by the sound effects.
+    size_t soundBytes() const;
+};
@@ -0,0 +1,105 @@
+#include "EndlessMode.h"
+
+#include <cmath>
+#include <vector>
+
+using namespace sf;
+using namespace std;
+
+// Enough for the prefetch square plus a ring of chunks the player just left.
+static const size_t MAX_RESIDENT_CHUNKS = 64;
+
+EndlessMode::EndlessMode(uint64_t seed, Algorithm algorithm, int cellSize, Sprite& playerSprite, float playerScale)
+    : maze(seed, algorithm, MAX_RESIDENT_CHUNKS), cellSize(cellSize), playerSprite(playerSprite), playerScale(playerScale) {
+    maze.prefetchAround(0, 0, PREFETCH_RADIUS);
+}
+
+void EndlessMode::handleKey(Keyboard::Key key) {
+    if (key == Keyboard::Up && !maze.hasWall(playerX, playerY, WALL_TOP)) --playerY;
+    else if (key == Keyboard::Down && !maze.hasWall(playerX, playerY, WALL_BOTTOM)) ++playerY;
+    else if (key == Keyboard::Left && !maze.hasWall(playerX, playerY, WALL_LEFT)) --playerX;
+    else if (key == Keyboard::Right && !maze.hasWall(playerX, playerY, WALL_RIGHT)) ++playerX;
+    else return;
+    ++movesMade;
+}
+
+void EndlessMode::update() {
+    maze.collectReady();
+    maze.prefetchAround(ChunkedMaze::chunkOf(playerX), ChunkedMaze::chunkOf(playerY), PREFETCH_RADIUS);
+}
+
+VertexArray EndlessMode::buildChunkMesh(int32_t chunkX, int32_t chunkY) {
+    VertexArray mesh(Lines);
+    int64_t originX = static_cast<int64_t>(chunkX) * CHUNK_SIZE;
+    int64_t originY = static_cast<int64_t>(chunkY) * CHUNK_SIZE;
+
+    // Each cell draws its right and bottom walls; the top row and left column also draw the
+    // seam they share with the chunk above or to the left.
+    for (int y = 0; y < CHUNK_SIZE; ++y) {
+        for (int x = 0; x < CHUNK_SIZE; ++x) {
+            int64_t worldX = originX + x, worldY = originY + y;
+            float left = static_cast<float>(worldX * cellSize), top = static_cast<float>(worldY * cellSize);
+            float right = left + cellSize, bottom = top + cellSize;
+
+            if (maze.hasWall(worldX, worldY, WALL_RIGHT)) {
+                mesh.append(Vertex(Vector2f(right, top), Color::White));
+                mesh.append(Vertex(Vector2f(right, bottom), Color::White));
+            }
+            if (maze.hasWall(worldX, worldY, WALL_BOTTOM)) {
+                mesh.append(Vertex(Vector2f(left, bottom), Color::White));
+                mesh.append(Vertex(Vector2f(right, bottom), Color::White));
+            }
+            if (x == 0 && maze.hasWall(worldX, worldY, WALL_LEFT)) {
+                mesh.append(Vertex(Vector2f(left, top), Color::White));
+                mesh.append(Vertex(Vector2f(left, bottom), Color::White));
+            }
+            if (y == 0 && maze.hasWall(worldX, worldY, WALL_TOP)) {
+                mesh.append(Vertex(Vector2f(left, top), Color::White));
+                mesh.append(Vertex(Vector2f(right, top), Color::White));
+            }
+        }
+    }
+    return mesh;
+}
+
+void EndlessMode::draw(RenderWindow& window) {
+    window.clear(Color::Black);
+
+    // The camera follows the player; pixel positions are world cells times cellSize, which
+    // stays exact in a float for any distance a player will realistically walk.
+    Vector2f center((playerX + 0.5f) * cellSize, (playerY + 0.5f) * cellSize);
+    View camera(center, Vector2f(static_cast<float>(window.getSize().x), static_cast<float>(window.getSize().y)));
+    window.setView(camera);
+
+    // Floored, not truncated: left of or above the origin truncation would pick the cell toward zero
+    int32_t firstX = ChunkedMaze::chunkOf(static_cast<int64_t>(floor((center.x - camera.getSize().x / 2) / cellSize)));
+    int32_t lastX = ChunkedMaze::chunkOf(static_cast<int64_t>(floor((center.x + camera.getSize().x / 2) / cellSize)));
+    int32_t firstY = ChunkedMaze::chunkOf(static_cast<int64_t>(floor((center.y - camera.getSize().y / 2) / cellSize)));
+    int32_t lastY = ChunkedMaze::chunkOf(static_cast<int64_t>(floor((center.y + camera.getSize().y / 2) / cellSize)));
+
+    for (int32_t chunkY = firstY; chunkY <= lastY; ++chunkY) {
+        for (int32_t chunkX = firstX; chunkX <= lastX; ++chunkX) {
+            uint64_t key = meshKey(chunkX, chunkY);
+            auto found = chunkMeshes.find(key);
+            if (found == chunkMeshes.end()) {
+                found = chunkMeshes.emplace(key, buildChunkMesh(chunkX, chunkY)).first;
+            }
+            window.draw(found->second);
+        }
+    }
+
+    // Meshes only live while their chunk is on screen (plus a one-chunk margin).
+    for (auto it = chunkMeshes.begin(); it != chunkMeshes.end();) {
+        int32_t chunkX = static_cast<int32_t>(it->first >> 32);
+        int32_t chunkY = static_cast<int32_t>(it->first & 0xFFFFFFFFu);
+        bool nearView = chunkX >= firstX - 1 && chunkX <= lastX + 1 && chunkY >= firstY - 1 && chunkY <= lastY + 1;
+        it = nearView ? next(it) : chunkMeshes.erase(it);
+    }
+
+    playerSprite.setPosition(
+        playerX * cellSize - (cellSize * (playerScale - 1)) / 2,
+        playerY * cellSize - (cellSize * (playerScale - 1)) / 2);
+    window.draw(playerSprite);
+
+    window.setView(window.getDefaultView());
+}
@@ -0,0 +1,46 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include "MazeCore/ChunkedMaze.h"
+
+#include <cstdint>
+#include <unordered_map>
+
+// Endless mode: an unbounded ChunkedMaze with the camera following the player. Only chunks
+// in view get a wall mesh, and chunks around the player are generated in the background
+// before the player reaches them.
+class EndlessMode {
+private:
+    ChunkedMaze maze;
+    int cellSize;
+    int64_t playerX = 0, playerY = 0;
+    int64_t movesMade = 0;
+    std::unordered_map<uint64_t, sf::VertexArray> chunkMeshes;
+    sf::Sprite& playerSprite;
+    float playerScale;
+
+    static uint64_t meshKey(int32_t chunkX, int32_t chunkY) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(chunkX)) << 32) | static_cast<uint32_t>(chunkY);
+    }
+
+    sf::VertexArray buildChunkMesh(int32_t chunkX, int32_t chunkY);
+
+public:
+    // Chunks within this many chunks of the player are generated ahead of time.
+    static const int PREFETCH_RADIUS = 2;
+
+    EndlessMode(uint64_t seed, Algorithm algorithm, int cellSize, sf::Sprite& playerSprite, float playerScale);
+
+    // Arrow key presses move the player; walls block as in the normal game.
+    void handleKey(sf::Keyboard::Key key);
+
+    // Collects background chunks and queues the ones the player is heading towards.
+    void update();
+
+    void draw(sf::RenderWindow& window);
+
+    int64_t getMovesMade() const { return movesMade; }
+    size_t loadedChunks() const { return maze.loadedChunks(); }
+    uint64_t getSeed() const { return maze.getSeed(); }
+};
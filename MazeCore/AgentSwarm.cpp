@@ -0,0 +1,174 @@
+#include "AgentSwarm.h"
+
+#include <algorithm>
+
+using namespace std;
+
+namespace {
+    // Agents per range below which another thread costs more than it saves.
+    const size_t MIN_RANGE_AGENTS = 4096;
+
+    // Weight of a way, before the trail divides it: twice as much for a step nearer the treasure.
+    const uint32_t NEARER_WEIGHT = 2048;
+    const uint32_t FURTHER_WEIGHT = 1024;
+
+    // Heading of an agent that has not moved yet: its way back, 1 << (4 ^ 2), is no wall bit.
+    const uint8_t NO_HEADING = 4;
+
+    uint64_t mix(uint64_t value) {
+        value ^= value >> 30;
+        value *= 0xBF58476D1CE4E5B9ull;
+        value ^= value >> 27;
+        value *= 0x94D049BB133111EBull;
+        return value ^ (value >> 31);
+    }
+}
+
+AgentSwarm::AgentSwarm(const Graph& graph, int threads) : graph(graph) {
+    rangeCount = threads > 0 ? threads : max(1, static_cast<int>(thread::hardware_concurrency()));
+    rangeArrivals.resize(rangeCount);
+    trail.resize(graph.cellCount());
+}
+
+AgentSwarm::~AgentSwarm() {
+    {
+        lock_guard<mutex> lock(workMutex);
+        stopping = true;
+    }
+    workReady.notify_all();
+    for (thread& worker : workers) {
+        worker.join();
+    }
+}
+
+void AgentSwarm::reset(size_t agentCount, int startCell, int target, uint64_t newSeed) {
+    targetCell = target;
+    seed = newSeed;
+    steps = 0;
+    arrived = 0;
+    firstArrival = -1;
+    cells.assign(agentCount, static_cast<uint32_t>(startCell));
+    headings.assign(agentCount, NO_HEADING);
+    arrivedAt.assign(agentCount, -1);
+    trail.assign(graph.cellCount(), 0);
+    trail[startCell] = static_cast<uint16_t>(min<size_t>(agentCount, UINT16_MAX));
+
+    // The workers start with the first swarm big enough to split, and then stay for the next ones.
+    if (workers.empty() && agentCount >= 2 * MIN_RANGE_AGENTS) {
+        for (int range = 1; range < rangeCount; ++range) {
+            workers.emplace_back(&AgentSwarm::workerLoop, this, range);
+        }
+    }
+}
+
+void AgentSwarm::stepRange(int range) {
+    // Ranges are recomputed from the agent count each step, so they always split it evenly
+    size_t count = cells.size();
+    size_t ranges = workers.empty() ? 1 : min<size_t>(rangeCount, max<size_t>(1, count / MIN_RANGE_AGENTS));
+    rangeArrivals[range] = 0;
+    if (static_cast<size_t>(range) >= ranges) {
+        return;
+    }
+    size_t first = count * range / ranges, last = count * (range + 1) / ranges;
+
+    const uint8_t* walls = graph.wallBytes();
+    int columns = graph.getColumns();
+    int targetX = graph.cellX(targetCell), targetY = graph.cellY(targetCell);
+    const int offsets[4] = { -columns, 1, columns, -1 };
+    uint64_t stepKey = mix(seed ^ static_cast<uint64_t>(steps) * 0x9E3779B97F4A7C15ull);
+    size_t arrivals = 0;
+
+    for (size_t agent = first; agent < last; ++agent) {
+        if (arrivedAt[agent] >= 0) {
+            continue;
+        }
+        int cell = static_cast<int>(cells[agent]);
+        int x = graph.cellX(cell), y = graph.cellY(cell);
+        unsigned nearer = (targetY < y ? 1u : 0u) | (targetX > x ? 2u : 0u) | (targetY > y ? 4u : 0u) | (targetX < x ? 8u : 0u);
+        unsigned open = ~walls[cell] & 0xF;
+        unsigned back = 1u << (headings[agent] ^ 2);
+        if (open != back) {
+            open &= ~back;  // turn back only out of a dead end
+        }
+
+        uint32_t weights[4];
+        uint32_t total = 0;
+        for (int direction = 0; direction < 4; ++direction) {
+            weights[direction] = 0;
+            if (open & (1u << direction)) {
+                uint32_t weight = (nearer & (1u << direction)) ? NEARER_WEIGHT : FURTHER_WEIGHT;
+                weights[direction] = max<uint32_t>(1, weight / (1u + trail[cell + offsets[direction]]));
+                total += weights[direction];
+            }
+        }
+        if (total == 0) {
+            continue;  // a walled-in cell, only in a maze of one cell
+        }
+
+        uint32_t pick = static_cast<uint32_t>(((mix(stepKey ^ agent) >> 32) * total) >> 32);
+        int direction = 0;
+        while (pick >= weights[direction]) {
+            pick -= weights[direction];
+            ++direction;
+        }
+        cell += offsets[direction];
+        cells[agent] = static_cast<uint32_t>(cell);
+        headings[agent] = static_cast<uint8_t>(direction);
+        if (cell == targetCell) {
+            arrivedAt[agent] = steps;
+            ++arrivals;
+        }
+    }
+    rangeArrivals[range] = arrivals;
+}
+
+void AgentSwarm::workerLoop(int range) {
+    uint64_t seen = 0;
+    unique_lock<mutex> lock(workMutex);
+    while (true) {
+        workReady.wait(lock, [&] { return stopping || generation != seen; });
+        if (stopping) {
+            return;
+        }
+        seen = generation;
+        lock.unlock();
+
+        stepRange(range);
+
+        lock.lock();
+        if (--rangesLeft == 0) {
+            workDone.notify_one();
+        }
+    }
+}
+
+void AgentSwarm::step() {
+    if (!workers.empty()) {
+        {
+            lock_guard<mutex> lock(workMutex);
+            ++generation;
+            rangesLeft = rangeCount - 1;
+        }
+        workReady.notify_all();
+    }
+    stepRange(0);
+    if (!workers.empty()) {
+        unique_lock<mutex> lock(workMutex);
+        workDone.wait(lock, [&] { return rangesLeft == 0; });
+    }
+
+    // Every agent has chosen from the same trail; now their new cells are added to it.
+    for (size_t agent = 0; agent < cells.size(); ++agent) {
+        uint16_t& visits = trail[cells[agent]];
+        if (arrivedAt[agent] < 0 && visits < UINT16_MAX) {
+            ++visits;
+        }
+    }
+    for (size_t arrivals : rangeArrivals) {
+        arrived += arrivals;
+    }
+    if (firstArrival < 0 && arrived > 0) {
+        firstArrival = steps;
+    }
+    ++steps;
+}
@@ -0,0 +1,74 @@
+#pragma once
+
+#include "Graph.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Rival explorers racing the player to the treasure. Agents know nothing of the maze but the
+// walls around them and a trail shared by all of them: how many times agents have stepped on
+// each cell. At every step an agent picks one of its open ways, avoiding turning back unless
+// it is at a dead end, favouring less trodden cells and, a little, cells nearer the treasure.
+//
+// Agents are kept as a struct of arrays (cell, heading, arrival tick), so a step streams
+// through just those arrays. A step has two phases: every agent chooses its move from the trail
+// as the last step left it, split over the worker threads in contiguous ranges; then the moves
+// are added to the trail. Choices are drawn from a hash of the seed, agent and step, so a
+// swarm moves the same way on any number of threads.
+class AgentSwarm {
+private:
+    const Graph& graph;
+    int targetCell = 0;
+    uint64_t seed = 0;
+    int64_t steps = 0;
+
+    std::vector<uint32_t> cells;
+    std::vector<uint8_t> headings;      // direction of the last move: 0 up, 1 right, 2 down, 3 left
+    std::vector<int64_t> arrivedAt;     // step the agent reached the treasure, or -1
+    std::vector<uint16_t> trail;        // per cell, saturating
+    std::vector<size_t> rangeArrivals;  // per range, agents that arrived this step
+    size_t arrived = 0;
+    int64_t firstArrival = -1;
+
+    // Worker threads step ranges 1.. while the calling thread steps range 0. They are only
+    // started by the first reset() with enough agents to split. Guarded by workMutex.
+    int rangeCount;
+    std::vector<std::thread> workers;
+    std::mutex workMutex;
+    std::condition_variable workReady, workDone;
+    uint64_t generation = 0;
+    int rangesLeft = 0;
+    bool stopping = false;
+
+    void stepRange(int range);
+    void workerLoop(int range);
+
+public:
+    // threads 0 means one per hardware thread. No thread is started until a swarm needs them.
+    AgentSwarm(const Graph& graph, int threads = 0);
+    ~AgentSwarm();
+
+    AgentSwarm(const AgentSwarm&) = delete;
+    AgentSwarm& operator=(const AgentSwarm&) = delete;
+
+    // Puts agentCount agents on startCell, all heading for targetCell, and clears the trail.
+    // The graph must hold a finished maze, and is only read from here on.
+    void reset(size_t agentCount, int startCell, int targetCell, uint64_t seed);
+
+    // Moves every agent that has not arrived one cell.
+    void step();
+
+    size_t agentCount() const { return cells.size(); }
+    size_t arrivedCount() const { return arrived; }
+    int64_t getSteps() const { return steps; }
+
+    // Step the first agent reached the treasure on, or -1.
+    int64_t getFirstArrival() const { return firstArrival; }
+
+    const std::vector<uint32_t>& getCells() const { return cells; }
+    int threadCount() const { return rangeCount; }
+};
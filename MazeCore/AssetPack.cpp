@@ -0,0 +1,92 @@
+#include "AssetPack.h"
+
+#include "ByteIO.h"
+
+#include <cstring>
+
+using namespace std;
+
+namespace {
+    const char ASSET_MAGIC[4] = { 'M', 'Q', 'A', 'S' };
+    const uint16_t ASSET_VERSION = 1;
+    const size_t ASSET_HEADER_SIZE = 16;
+    const size_t ENTRY_SIZE = 18;  // without the name
+}
+
+bool AssetPack::open(const string& path) {
+    close();
+    if (!file.open(path)) {
+        return false;
+    }
+    const uint8_t* data = file.data();
+    size_t size = file.size();
+    if (size < ASSET_HEADER_SIZE || memcmp(data, ASSET_MAGIC, sizeof(ASSET_MAGIC)) != 0
+        || getLittleEndian(data + 4, 2) != ASSET_VERSION) {
+        close();
+        return false;
+    }
+
+    uint64_t count = getLittleEndian(data + 8, 4);
+    const uint8_t* cursor = data + ASSET_HEADER_SIZE;
+    const uint8_t* end = data + size;
+    for (uint64_t i = 0; i < count; ++i) {
+        if (static_cast<size_t>(end - cursor) < ENTRY_SIZE) {
+            close();
+            return false;
+        }
+        Entry entry;
+        entry.offset = getLittleEndian(cursor, 8);
+        entry.size = getLittleEndian(cursor + 8, 8);
+        size_t nameLength = static_cast<size_t>(getLittleEndian(cursor + 16, 2));
+        cursor += ENTRY_SIZE;
+        if (static_cast<size_t>(end - cursor) < nameLength || entry.offset > size || entry.size > size - entry.offset) {
+            close();
+            return false;
+        }
+        entry.name.assign(reinterpret_cast<const char*>(cursor), nameLength);
+        cursor += nameLength;
+        entries.push_back(move(entry));
+    }
+    return true;
+}
+
+void AssetPack::close() {
+    file.close();
+    entries.clear();
+}
+
+bool AssetPack::find(const string& name, const uint8_t*& data, size_t& size) const {
+    // A pack holds a handful of assets, so a scan is as quick as any index.
+    for (const Entry& entry : entries) {
+        if (entry.name == name) {
+            data = file.data() + entry.offset;
+            size = static_cast<size_t>(entry.size);
+            return true;
+        }
+    }
+    return false;
+}
+
+void appendAssetPack(string& out, const vector<string>& names, const vector<string>& contents) {
+    size_t tableSize = 0;
+    for (const string& name : names) {
+        tableSize += ENTRY_SIZE + name.size();
+    }
+
+    out.append(ASSET_MAGIC, sizeof(ASSET_MAGIC));
+    putLittleEndian(out, ASSET_VERSION, 2);
+    putLittleEndian(out, 0, 2);
+    putLittleEndian(out, static_cast<uint32_t>(names.size()), 4);
+    putLittleEndian(out, 0, 4);
+    uint64_t offset = ASSET_HEADER_SIZE + tableSize;
+    for (size_t i = 0; i < names.size(); ++i) {
+        putLittleEndian(out, offset, 8);
+        putLittleEndian(out, contents[i].size(), 8);
+        putLittleEndian(out, names[i].size(), 2);
+        out += names[i];
+        offset += contents[i].size();
+    }
+    for (const string& content : contents) {
+        out += content;
+    }
+}
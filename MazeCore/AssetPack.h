@@ -0,0 +1,42 @@
+#pragma once
+
+#include "MappedFile.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Asset pack ("MQAS"), little-endian:
+//
+//    0  "MQAS"   4  version (u16)   6  reserved (u16)   8  asset count (u32)   12  reserved (u32)
+//   16  count entries: offset (u64) and size (u64) from the start of the file, name length
+//       (u16), name (a relative path with forward slashes, such as "Sound/achievement.wav")
+//
+// followed by the assets' bytes, each as it was on disk. Like a level pack it is read through a
+// memory mapping, so decoders read the assets where they lie and nothing is copied out first.
+class AssetPack {
+private:
+    struct Entry {
+        std::string name;
+        uint64_t offset, size;
+    };
+
+    MappedFile file;
+    std::vector<Entry> entries;
+
+public:
+    // Returns false, leaving the pack closed, unless path is a whole pack of a known version.
+    bool open(const std::string& path);
+    void close();
+
+    bool isOpen() const { return file.isOpen(); }
+    size_t assetCount() const { return entries.size(); }
+
+    // The bytes of the asset called name, straight from the mapping; valid while the pack is open.
+    bool find(const std::string& name, const uint8_t*& data, size_t& size) const;
+};
+
+// Appends a pack of the given assets, names[i] holding contents[i]. Offsets count from the
+// start of out, so out is expected to be empty: the pack is written as a file of its own.
+void appendAssetPack(std::string& out, const std::vector<std::string>& names, const std::vector<std::string>& contents);
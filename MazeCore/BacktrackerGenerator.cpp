@@ -0,0 +1,19 @@
+#include "BacktrackerGenerator.h"
+
+using namespace std;
+
+void BacktrackerGenerator::start() {
+    path.clear();
+    carved = 0;
+    currentNode = graph.getNode(0, 0);
+    graph.setVisited(currentNode);
+    path.push_back(currentNode);
+}
+
+bool BacktrackerGenerator::step() {
+    if (isDone() || !backtrackerStep(graph, path, rng, currentNode)) {
+        return false;
+    }
+    ++carved;
+    return true;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "MazeGenerator.h"
+#include "Rng.h"
+
+#include <vector>
+
+// One step of the backtracker on any grid with Graph's cell calls (getNeighbors, isVisited,
+// setVisited, removeWalls) and any path with vector's back end. Backing out of dead ends
+// carves nothing, so it pops until one cell is carved (true) or the path is empty (false).
+// The generator below and the compile-time baker (BakedMaze.h) both run this, so the same
+// seed carves the same maze in either.
+template <typename Grid, typename Path>
+constexpr bool backtrackerStep(Grid& grid, Path& path, Rng& rng, int& current) {
+    while (!path.empty()) {
+        int cell = path.back();
+        int neighbors[4] = {};
+        int count = grid.getNeighbors(cell, neighbors);
+        int unvisitedCount = 0;
+
+        for (int i = 0; i < count; ++i) {
+            if (!grid.isVisited(neighbors[i])) {
+                neighbors[unvisitedCount++] = neighbors[i];
+            }
+        }
+
+        if (unvisitedCount == 0) {
+            path.pop_back();
+            continue;
+        }
+
+        int next = neighbors[rng.bounded(unvisitedCount)];
+        grid.removeWalls(cell, next);
+        grid.setVisited(next);
+        path.push_back(next);
+        current = next;
+        return true;
+    }
+    return false;
+}
+
+// Recursive backtracker (randomized depth-first search) with an explicit stack, so a long
+// corridor cannot overflow the call stack. Produces long winding passages; the stack holds
+// the current path, which is the algorithm's only memory besides the visited bits.
+class BacktrackerGenerator : public MazeGenerator {
+private:
+    std::vector<int> path;
+    int carved = 0;
+
+protected:
+    void start() override;
+
+public:
+    explicit BacktrackerGenerator(Graph& graph) : MazeGenerator(graph) {}
+
+    Algorithm getAlgorithm() const override { return Algorithm::Backtracker; }
+    bool isDone() const override { return carved >= graph.cellCount() - 1 || path.empty(); }
+    bool step() override;
+    size_t workingMemoryBytes() const override { return path.capacity() * sizeof(int); }
+};
@@ -0,0 +1,49 @@
+#include "BakedLevels.h"
+
+#include "BakedMaze.h"
+
+using namespace std;
+
+namespace {
+    const uint64_t DAILY_BASE_SEED = 0xDA117;
+
+    using TutorialMaze = BakedMaze<10, 5, 0x7E5701>;
+    template <uint64_t DAY>
+    using DailyMaze = BakedMaze<20, 10, deriveSeed(DAILY_BASE_SEED, DAY)>;
+
+    // Checked by the compiler: every baked level is a perfect maze, and its walls hash to what
+    // BacktrackerGenerator builds at run time from the same seed. A change to the generator or
+    // Rng that moves any maze fails the build here rather than shipping different levels.
+    static_assert(isPerfectBake(TutorialMaze::maze), "tutorial maze is not perfect");
+    static_assert(isPerfectBake(DailyMaze<0>::maze) && isPerfectBake(DailyMaze<1>::maze)
+        && isPerfectBake(DailyMaze<2>::maze) && isPerfectBake(DailyMaze<3>::maze) && isPerfectBake(DailyMaze<4>::maze)
+        && isPerfectBake(DailyMaze<5>::maze) && isPerfectBake(DailyMaze<6>::maze), "a daily maze is not perfect");
+    static_assert(TutorialMaze::fingerprint() == 0xC5F6C3F65CB652C0ull, "tutorial maze differs from runtime generation");
+    static_assert(DailyMaze<0>::fingerprint() == 0xDACFC770DE572150ull, "daily maze 0 differs from runtime generation");
+    static_assert(DailyMaze<1>::fingerprint() == 0xA0E9F011029339B8ull, "daily maze 1 differs from runtime generation");
+    static_assert(DailyMaze<2>::fingerprint() == 0x71E33E383C82297Dull, "daily maze 2 differs from runtime generation");
+    static_assert(DailyMaze<3>::fingerprint() == 0xC83FFDA3B1660D73ull, "daily maze 3 differs from runtime generation");
+    static_assert(DailyMaze<4>::fingerprint() == 0x04BA46C3FA7D44B3ull, "daily maze 4 differs from runtime generation");
+    static_assert(DailyMaze<5>::fingerprint() == 0xEB602A88829EEB78ull, "daily maze 5 differs from runtime generation");
+    static_assert(DailyMaze<6>::fingerprint() == 0x791BAB17684F857Full, "daily maze 6 differs from runtime generation");
+
+    template <typename Maze>
+    constexpr BakedLevel describe(const char* name) {
+        return { name, Maze::columns, Maze::rows, Maze::seed, Maze::maze.walls.data(), Maze::maze.carveLog.data(), Maze::maze.carveLog.size() };
+    }
+
+    const BakedLevel TUTORIAL = describe<TutorialMaze>("Tutorial");
+    const BakedLevel DAILY[DAILY_LEVEL_COUNT] = {
+        describe<DailyMaze<0>>("Daily 1"), describe<DailyMaze<1>>("Daily 2"), describe<DailyMaze<2>>("Daily 3"),
+        describe<DailyMaze<3>>("Daily 4"), describe<DailyMaze<4>>("Daily 5"), describe<DailyMaze<5>>("Daily 6"),
+        describe<DailyMaze<6>>("Daily 7"),
+    };
+}
+
+const BakedLevel& tutorialLevel() {
+    return TUTORIAL;
+}
+
+const BakedLevel& dailyLevel(int64_t day) {
+    return DAILY[((day % DAILY_LEVEL_COUNT) + DAILY_LEVEL_COUNT) % DAILY_LEVEL_COUNT];
+}
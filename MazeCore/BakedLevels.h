@@ -0,0 +1,24 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+// Levels compiled into the game: the tutorial, and a week of daily challenges that repeats.
+// Each is a BakedMaze (BakedMaze.h), so its walls and carve order are static tables and the
+// game plays it without generating anything. They are the backtracker's mazes for their seeds,
+// so replays and tools rebuild them with makeGenerator(Algorithm::Backtracker, ...).
+struct BakedLevel {
+    const char* name;
+    int columns, rows;
+    uint64_t seed;
+    const uint8_t* walls;       // Graph::wallBytes() of the finished maze
+    const uint32_t* carveLog;   // Graph::getCarveLog() entries, in the order generation carved them
+    size_t carves;
+};
+
+const int DAILY_LEVEL_COUNT = 7;
+
+const BakedLevel& tutorialLevel();
+
+// The challenge for day (days since 1970-01-01, UTC).
+const BakedLevel& dailyLevel(int64_t day);
@@ -0,0 +1,163 @@
+#pragma once
+
+#include "BacktrackerGenerator.h"
+#include "Graph.h"
+#include "Rng.h"
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// Mazes generated by the compiler. A BakedMaze<COLUMNS, ROWS, SEED> is the maze the
+// backtracker generator carves from SEED at that size, as static tables of wall bytes and
+// carve order in the binary's read-only data: nothing is generated or allocated for it at
+// run time. It runs the generator's own step (backtrackerStep) and Rng, so the tables are
+// the same maze makeGenerator(Algorithm::Backtracker, ...) builds from that seed.
+
+// FNV-1a over wall bytes, usable on a baked table at compile time or Graph::wallBytes() at run time.
+constexpr uint64_t wallFingerprint(const uint8_t* walls, size_t count) {
+    uint64_t hash = 0xCBF29CE484222325ull;
+    for (size_t i = 0; i < count; ++i) {
+        hash = (hash ^ walls[i]) * 0x100000001B3ull;
+    }
+    return hash;
+}
+
+// What baking leaves: Graph's wall bytes and carve log, in fixed-size arrays.
+template <int COLUMNS, int ROWS>
+struct BakedWalls {
+    static_assert(COLUMNS >= 2 && ROWS >= 2, "a baked maze needs at least 2x2 cells");
+    static constexpr int CELLS = COLUMNS * ROWS;
+
+    std::array<uint8_t, CELLS> walls{};
+    std::array<uint32_t, CELLS - 1> carveLog{};
+};
+
+namespace baking {
+    // Graph's cell calls on fixed arrays, for backtrackerStep to carve into.
+    template <int COLUMNS, int ROWS>
+    class Grid {
+    private:
+        static constexpr int CELLS = COLUMNS * ROWS;
+        std::array<bool, CELLS> visited{};
+        int carves = 0;
+
+    public:
+        BakedWalls<COLUMNS, ROWS> result;
+
+        constexpr Grid() {
+            for (uint8_t& cell : result.walls) {
+                cell = ALL_WALLS;
+            }
+        }
+
+        constexpr int getNeighbors(int cell, int out[4]) const {
+            int x = cell % COLUMNS;
+            int count = 0;
+            if (x > 0) out[count++] = cell - 1;
+            if (x < COLUMNS - 1) out[count++] = cell + 1;
+            if (cell >= COLUMNS) out[count++] = cell - COLUMNS;
+            if (cell < CELLS - COLUMNS) out[count++] = cell + COLUMNS;
+            return count;
+        }
+
+        constexpr bool isVisited(int cell) const { return visited[cell]; }
+        constexpr void setVisited(int cell) { visited[cell] = true; }
+
+        // Same walls and edge ids as Graph::removeWalls(); neighbours are never a row apart here.
+        constexpr void removeWalls(int current, int neighbor) {
+            int delta = neighbor - current;
+            int first = delta > 0 ? current : neighbor;
+            if (delta == COLUMNS || delta == -COLUMNS) {
+                result.walls[first] &= ~WALL_BOTTOM;
+                result.walls[first + COLUMNS] &= ~WALL_TOP;
+                result.carveLog[carves++] = static_cast<uint32_t>(first * 2 + 1);
+            }
+            else {
+                result.walls[first] &= ~WALL_RIGHT;
+                result.walls[first + 1] &= ~WALL_LEFT;
+                result.carveLog[carves++] = static_cast<uint32_t>(first * 2);
+            }
+        }
+    };
+
+    // The backtracker's path, on a fixed array that holds every cell at worst.
+    template <size_t CAPACITY>
+    class Path {
+    private:
+        std::array<int, CAPACITY> cells{};
+        size_t count = 0;
+
+    public:
+        constexpr bool empty() const { return count == 0; }
+        constexpr int back() const { return cells[count - 1]; }
+        constexpr void push_back(int cell) { cells[count++] = cell; }
+        constexpr void pop_back() { --count; }
+    };
+}
+
+// BacktrackerGenerator::start() then step() until done, at compile time.
+template <int COLUMNS, int ROWS>
+constexpr BakedWalls<COLUMNS, ROWS> bakeBacktracker(uint64_t seed) {
+    baking::Grid<COLUMNS, ROWS> grid;
+    baking::Path<COLUMNS * ROWS> path;
+    Rng rng(seed);
+    int current = 0;
+    grid.setVisited(current);
+    path.push_back(current);
+    while (backtrackerStep(grid, path, rng, current)) {
+    }
+    return grid.result;
+}
+
+// A perfect maze: cells - 1 openings, every cell reachable from the first and a closed border.
+// The compile-time counterpart of validateMaze() (WallPlanes.h).
+template <int COLUMNS, int ROWS>
+constexpr bool isPerfectBake(const BakedWalls<COLUMNS, ROWS>& maze) {
+    constexpr int CELLS = COLUMNS * ROWS;
+    int openings = 0;
+    for (int cell = 0; cell < CELLS; ++cell) {
+        int x = cell % COLUMNS, y = cell / COLUMNS;
+        uint8_t walls = maze.walls[cell];
+        if ((y == 0 && !(walls & WALL_TOP)) || (x == 0 && !(walls & WALL_LEFT))
+            || (y == ROWS - 1 && !(walls & WALL_BOTTOM)) || (x == COLUMNS - 1 && !(walls & WALL_RIGHT))) {
+            return false;
+        }
+        openings += !(walls & WALL_RIGHT) + !(walls & WALL_BOTTOM);
+    }
+    if (openings != CELLS - 1) {
+        return false;
+    }
+
+    std::array<bool, CELLS> reached{};
+    std::array<int, CELLS> stack{};
+    int top = 0, count = 1;
+    reached[0] = true;
+    stack[top++] = 0;
+    while (top > 0) {
+        int cell = stack[--top];
+        uint8_t walls = maze.walls[cell];
+        int next[4] = { cell - COLUMNS, cell + 1, cell + COLUMNS, cell - 1 };
+        for (int direction = 0; direction < 4; ++direction) {
+            if (!(walls & (1 << direction)) && !reached[next[direction]]) {
+                reached[next[direction]] = true;
+                stack[top++] = next[direction];
+                ++count;
+            }
+        }
+    }
+    return count == CELLS;
+}
+
+template <int COLUMNS, int ROWS, uint64_t SEED>
+struct BakedMaze {
+    static constexpr int columns = COLUMNS;
+    static constexpr int rows = ROWS;
+    static constexpr uint64_t seed = SEED;
+    static constexpr BakedWalls<COLUMNS, ROWS> maze = bakeBacktracker<COLUMNS, ROWS>(SEED);
+
+    // Graph's lookups with the dimensions known to the compiler.
+    static constexpr int getNode(int x, int y) { return y * COLUMNS + x; }
+    static constexpr bool hasWall(int x, int y, Wall wall) { return (maze.walls[getNode(x, y)] & wall) != 0; }
+    static constexpr uint64_t fingerprint() { return wallFingerprint(maze.walls.data(), maze.walls.size()); }
+};
@@ -0,0 +1,206 @@
+#include "Bot.h"
+
+#include <cctype>
+#include <cstdlib>
+#include <vector>
+
+using namespace std;
+
+namespace {
+    // Indexed by Move.
+    const Wall MOVE_WALLS[] = { WALL_TOP, WALL_BOTTOM, WALL_LEFT, WALL_RIGHT };
+    const int MOVE_DX[] = { 0, 0, -1, 1 };
+    const int MOVE_DY[] = { -1, 1, 0, 0 };
+
+    // Moves in clockwise order, for turning.
+    const Move CLOCKWISE[] = { Move::Up, Move::Right, Move::Down, Move::Left };
+
+    int openExits(const Graph& graph, int cell) {
+        int exits = 0;
+        for (Wall wall : MOVE_WALLS) {
+            exits += graph.hasWall(cell, wall) ? 0 : 1;
+        }
+        return exits;
+    }
+
+    int moveTarget(const Graph& graph, int cell, Move move) {
+        int direction = static_cast<int>(move);
+        return graph.getNode(graph.cellX(cell) + MOVE_DX[direction], graph.cellY(cell) + MOVE_DY[direction]);
+    }
+
+    // Any open direction, uniformly.
+    class RandomBot : public Bot {
+    private:
+        const Graph* graph = nullptr;
+        Rng rng;
+
+    public:
+        BotKind getKind() const override { return BotKind::Random; }
+
+        void start(const Graph& maze, uint64_t seed) override {
+            graph = &maze;
+            rng.seed(seed);
+        }
+
+        Move nextMove(const GameSession& session) override {
+            Move open[4];
+            int count = 0;
+            for (int direction = 0; direction < 4; ++direction) {
+                if (!graph->hasWall(session.getCell(), MOVE_WALLS[direction])) {
+                    open[count++] = static_cast<Move>(direction);
+                }
+            }
+            return open[rng.bounded(count)];
+        }
+    };
+
+    // Keeps its right hand on the wall: right if it can, else straight, else left, else back.
+    // In a perfect maze that always reaches the treasure, at the price of walking dead ends twice.
+    class WallFollowerBot : public Bot {
+    private:
+        const Graph* graph = nullptr;
+        int heading = 0;  // index into CLOCKWISE
+
+    public:
+        BotKind getKind() const override { return BotKind::WallFollower; }
+
+        void start(const Graph& maze, uint64_t) override {
+            graph = &maze;
+            heading = 2;  // facing down into the maze from the entrance
+        }
+
+        Move nextMove(const GameSession& session) override {
+            static const int TURNS[] = { 1, 0, 3, 2 };
+            for (int turn : TURNS) {
+                int direction = (heading + turn) % 4;
+                if (!graph->hasWall(session.getCell(), MOVE_WALLS[static_cast<int>(CLOCKWISE[direction])])) {
+                    heading = direction;
+                    break;
+                }
+            }
+            return CLOCKWISE[heading];
+        }
+    };
+
+    // Depth-first search the way a person does it: take an unexplored passage, the one that
+    // points most towards the treasure (ties at random), and back up only out of a dead end.
+    // Its stack of cells is exactly the session's trail, so every step back is an undo.
+    class ExplorerBot : public Bot {
+    private:
+        const Graph* graph = nullptr;
+        Rng rng;
+        vector<uint32_t> visitedRound;  // cell visited this round when equal to round
+        uint32_t round = 0;
+        vector<int> path;
+
+    public:
+        BotKind getKind() const override { return BotKind::Explorer; }
+
+        void start(const Graph& maze, uint64_t seed) override {
+            graph = &maze;
+            rng.seed(seed);
+            if (visitedRound.size() != static_cast<size_t>(maze.cellCount())) {
+                visitedRound.assign(maze.cellCount(), 0);
+                round = 0;
+            }
+            ++round;
+            path.clear();
+        }
+
+        Move nextMove(const GameSession& session) override {
+            int cell = session.getCell();
+            visitedRound[cell] = round;
+            int goalX = graph->getColumns() - 1, goalY = graph->getRows() - 1;
+
+            Move best = Move::Up;
+            int bestDistance = -1, ties = 0;
+            for (int direction = 0; direction < 4; ++direction) {
+                if (graph->hasWall(cell, MOVE_WALLS[direction])) {
+                    continue;
+                }
+                int next = moveTarget(*graph, cell, static_cast<Move>(direction));
+                if (visitedRound[next] == round) {
+                    continue;
+                }
+                int distance = abs(goalX - graph->cellX(next)) + abs(goalY - graph->cellY(next));
+                if (bestDistance < 0 || distance < bestDistance) {
+                    best = static_cast<Move>(direction);
+                    bestDistance = distance;
+                    ties = 1;
+                }
+                else if (distance == bestDistance && rng.bounded(++ties) == 0) {
+                    best = static_cast<Move>(direction);
+                }
+            }
+            if (bestDistance >= 0) {
+                path.push_back(cell);
+                return best;
+            }
+
+            // Dead end: back to the cell we came from
+            int previous = path.back();
+            path.pop_back();
+            for (int direction = 0; direction < 4; ++direction) {
+                if (!graph->hasWall(cell, MOVE_WALLS[direction]) && moveTarget(*graph, cell, static_cast<Move>(direction)) == previous) {
+                    return static_cast<Move>(direction);
+                }
+            }
+            return best;
+        }
+    };
+
+    // Uniform in [scale / 2, scale * 3 / 2) seconds, in whole ticks.
+    int64_t waitTicks(Rng& rng, float scale) {
+        float seconds = scale * (0.5f + (rng.next() >> 40) * (1.0f / (1 << 24)));
+        return static_cast<int64_t>(seconds * GameSession::TICK_RATE);
+    }
+}
+
+const char* botName(BotKind kind) {
+    switch (kind) {
+    case BotKind::Random: return "RANDOM";
+    case BotKind::WallFollower: return "WALL";
+    case BotKind::Explorer: return "EXPLORER";
+    }
+    return "UNKNOWN";
+}
+
+bool parseBot(const string& name, BotKind& kind) {
+    string upper = name;
+    for (char& c : upper) {
+        c = static_cast<char>(toupper(static_cast<unsigned char>(c)));
+    }
+
+    for (int i = 0; i < BOT_KIND_COUNT; ++i) {
+        if (upper == botName(static_cast<BotKind>(i))) {
+            kind = static_cast<BotKind>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+unique_ptr<Bot> makeBot(BotKind kind) {
+    switch (kind) {
+    case BotKind::Random: return unique_ptr<Bot>(new RandomBot());
+    case BotKind::WallFollower: return unique_ptr<Bot>(new WallFollowerBot());
+    case BotKind::Explorer: return unique_ptr<Bot>(new ExplorerBot());
+    }
+    return nullptr;
+}
+
+SessionState playRound(GameSession& session, const Graph& graph, Bot& bot, Rng& rng, const BotTiming& timing) {
+    bot.start(graph, rng.next());
+    while (session.getState() == SessionState::Playing) {
+        // Every key press takes at least a tick, so the clock always runs the round out eventually
+        int64_t wait = waitTicks(rng, timing.secondsPerMove);
+        if (openExits(graph, session.getCell()) != 2) {
+            wait += waitTicks(rng, timing.secondsPerChoice);
+        }
+        session.advance(wait > 0 ? wait : 1);
+        if (session.getState() == SessionState::Playing) {
+            session.move(bot.nextMove(session));
+        }
+    }
+    return session.getState();
+}
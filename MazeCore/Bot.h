@@ -0,0 +1,47 @@
+#pragma once
+
+#include "GameSession.h"
+#include "Graph.h"
+#include "Rng.h"
+
+#include <cstdint>
+#include <memory>
+#include <string>
+
+enum class BotKind { Random, WallFollower, Explorer };
+
+const int BOT_KIND_COUNT = 3;
+
+// Upper-case name ("RANDOM", "WALL", "EXPLORER").
+const char* botName(BotKind kind);
+
+// Accepts the names above in any case. Returns false for anything else.
+bool parseBot(const std::string& name, BotKind& kind);
+
+// A player with no hands: it picks the next arrow key for a running GameSession. Bots only
+// press keys that lead somewhere (as a player looking at the screen would), so every move
+// they make is applied, and stepping back still costs an undo.
+class Bot {
+public:
+    virtual ~Bot() = default;
+
+    virtual BotKind getKind() const = 0;
+
+    // Called at the entrance before each round, on a finished maze.
+    virtual void start(const Graph& graph, uint64_t seed) = 0;
+
+    virtual Move nextMove(const GameSession& session) = 0;
+};
+
+std::unique_ptr<Bot> makeBot(BotKind kind);
+
+// How quickly a bot presses keys. Each move waits secondsPerMove, give or take half, and a
+// move out of a junction or dead end waits secondsPerChoice more, like a player looking around.
+struct BotTiming {
+    float secondsPerMove = 0.2f;
+    float secondsPerChoice = 0.5f;
+};
+
+// Plays a started session on graph to its end, skipping the ticks between key presses.
+// rng draws the timing, and the bot's own seed.
+SessionState playRound(GameSession& session, const Graph& graph, Bot& bot, Rng& rng, const BotTiming& timing);
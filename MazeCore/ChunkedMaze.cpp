@@ -0,0 +1,163 @@
+#include "ChunkedMaze.h"
+
+#include <cstdlib>
+#include <iterator>
+
+using namespace std;
+
+namespace {
+    // Mixes a seam or chunk position into the world seed. side keeps east and south seams of
+    // the same chunk (and the chunk's own maze) on unrelated values.
+    uint64_t positionHash(uint64_t worldSeed, int32_t chunkX, int32_t chunkY, uint64_t side) {
+        uint64_t state = worldSeed
+            ^ (static_cast<uint64_t>(static_cast<uint32_t>(chunkX)) * 0x9E3779B97F4A7C15ull)
+            ^ (static_cast<uint64_t>(static_cast<uint32_t>(chunkY)) * 0xC2B2AE3D27D4EB4Full)
+            ^ (side * 0x165667B19E3779F9ull);
+        splitmix64(state);
+        return splitmix64(state);
+    }
+
+    int doorOffset(uint64_t hash) {
+        return static_cast<int>(((hash >> 32) * CHUNK_SIZE) >> 32);
+    }
+}
+
+ChunkedMaze::ChunkedMaze(uint64_t worldSeed, Algorithm algorithm, size_t maxChunks)
+    : worldSeed(worldSeed), algorithm(algorithm), maxChunks(maxChunks) {
+    worker = thread(&ChunkedMaze::workerLoop, this);
+}
+
+ChunkedMaze::~ChunkedMaze() {
+    {
+        lock_guard<mutex> lock(queueMutex);
+        stopping = true;
+    }
+    queueReady.notify_all();
+    worker.join();
+}
+
+int ChunkedMaze::eastDoor(int32_t chunkX, int32_t chunkY) const {
+    return doorOffset(positionHash(worldSeed, chunkX, chunkY, 1));
+}
+
+int ChunkedMaze::southDoor(int32_t chunkX, int32_t chunkY) const {
+    return doorOffset(positionHash(worldSeed, chunkX, chunkY, 2));
+}
+
+unique_ptr<MazeChunk> ChunkedMaze::generateChunk(int32_t chunkX, int32_t chunkY) const {
+    unique_ptr<MazeChunk> chunk(new MazeChunk(chunkX, chunkY));
+    unique_ptr<MazeGenerator> generator = makeGenerator(algorithm, chunk->cells, positionHash(worldSeed, chunkX, chunkY, 0));
+    while (generator->step()) {
+    }
+    return chunk;
+}
+
+void ChunkedMaze::insert(unique_ptr<MazeChunk> chunk, bool recent) {
+    uint64_t key = chunkKey(chunk->chunkX, chunk->chunkY);
+    if (cache.count(key)) {
+        return;  // already loaded synchronously while the worker was still on it
+    }
+    if (!recent) {
+        if (cache.size() < maxChunks) {
+            lru.push_back(key);
+            cache.emplace(key, CacheEntry{ move(chunk), prev(lru.end()) });
+        }
+        return;
+    }
+
+    while (cache.size() >= maxChunks && !lru.empty()) {
+        cache.erase(lru.back());
+        lru.pop_back();
+    }
+    lru.push_front(key);
+    cache.emplace(key, CacheEntry{ move(chunk), lru.begin() });
+}
+
+const MazeChunk& ChunkedMaze::chunk(int32_t chunkX, int32_t chunkY) {
+    uint64_t key = chunkKey(chunkX, chunkY);
+    auto found = cache.find(key);
+    if (found == cache.end()) {
+        insert(generateChunk(chunkX, chunkY), true);
+        found = cache.find(key);
+    }
+    else {
+        lru.splice(lru.begin(), lru, found->second.lruPosition);
+    }
+    return *found->second.chunk;
+}
+
+bool ChunkedMaze::hasWall(int64_t x, int64_t y, Wall wall) {
+    int32_t chunkX = chunkOf(x), chunkY = chunkOf(y);
+    int localX = static_cast<int>(x - static_cast<int64_t>(chunkX) * CHUNK_SIZE);
+    int localY = static_cast<int>(y - static_cast<int64_t>(chunkY) * CHUNK_SIZE);
+
+    // Walls on a seam are closed except for the seam's single door.
+    if (wall == WALL_RIGHT && localX == CHUNK_SIZE - 1) return localY != eastDoor(chunkX, chunkY);
+    if (wall == WALL_LEFT && localX == 0) return localY != eastDoor(chunkX - 1, chunkY);
+    if (wall == WALL_BOTTOM && localY == CHUNK_SIZE - 1) return localX != southDoor(chunkX, chunkY);
+    if (wall == WALL_TOP && localY == 0) return localX != southDoor(chunkX, chunkY - 1);
+
+    return chunk(chunkX, chunkY).cells.hasWall(localY * CHUNK_SIZE + localX, wall);
+}
+
+void ChunkedMaze::prefetchAround(int32_t chunkX, int32_t chunkY, int radius) {
+    prefetchX = chunkX;
+    prefetchY = chunkY;
+    prefetchRadius = radius;
+    bool queued = false;
+    {
+        lock_guard<mutex> lock(queueMutex);
+        for (int32_t dy = -radius; dy <= radius; ++dy) {
+            for (int32_t dx = -radius; dx <= radius; ++dx) {
+                uint64_t key = chunkKey(chunkX + dx, chunkY + dy);
+                if (cache.count(key) || pending.count(key)) {
+                    continue;
+                }
+                pending.insert(key);
+                requests.push_back(key);
+                queued = true;
+            }
+        }
+    }
+    if (queued) {
+        queueReady.notify_one();
+    }
+}
+
+void ChunkedMaze::collectReady() {
+    vector<unique_ptr<MazeChunk>> delivered;
+    {
+        lock_guard<mutex> lock(queueMutex);
+        delivered.swap(finished);
+    }
+    for (unique_ptr<MazeChunk>& chunk : delivered) {
+        pending.erase(chunkKey(chunk->chunkX, chunk->chunkY));
+        bool nearPlayer = abs(static_cast<int64_t>(chunk->chunkX) - prefetchX) <= prefetchRadius
+            && abs(static_cast<int64_t>(chunk->chunkY) - prefetchY) <= prefetchRadius;
+        insert(move(chunk), nearPlayer);
+    }
+}
+
+void ChunkedMaze::workerLoop() {
+    unique_lock<mutex> lock(queueMutex);
+    while (true) {
+        queueReady.wait(lock, [this] { return stopping || !requests.empty(); });
+        if (stopping) {
+            return;
+        }
+
+        uint64_t key = requests.front();
+        requests.pop_front();
+        lock.unlock();
+
+        unique_ptr<MazeChunk> chunk = generateChunk(static_cast<int32_t>(key >> 32), static_cast<int32_t>(key & 0xFFFFFFFFu));
+
+        lock.lock();
+        finished.push_back(move(chunk));
+    }
+}
+
+size_t ChunkedMaze::memoryBytes() const {
+    size_t perChunk = sizeof(MazeChunk) + CHUNK_SIZE * CHUNK_SIZE + CHUNK_SIZE * CHUNK_SIZE / 8;
+    return cache.size() * perChunk;
+}
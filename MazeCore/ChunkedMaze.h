@@ -0,0 +1,105 @@
+#pragma once
+
+#include "Graph.h"
+#include "MazeGenerator.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+const int CHUNK_SIZE = 32;
+
+// One CHUNK_SIZE x CHUNK_SIZE block of an endless maze: a perfect maze of its own, plus one
+// door through each side. Door positions come from a hash of the seam itself, so the two
+// chunks sharing a seam always agree on it without either being loaded.
+struct MazeChunk {
+    int32_t chunkX, chunkY;
+    Graph cells;
+
+    MazeChunk(int32_t chunkX, int32_t chunkY) : chunkX(chunkX), chunkY(chunkY), cells(CHUNK_SIZE, CHUNK_SIZE) {}
+};
+
+// An unbounded maze generated chunk by chunk around the player. Every chunk is rebuilt from
+// (world seed, chunk position), so chunks can be evicted and come back identical later; an
+// LRU cache keeps at most maxChunks resident, which bounds memory however far the player
+// goes. Chunks around the player are generated ahead of time on a worker thread.
+//
+// Each chunk is internally perfect and every pair of neighboring chunks shares exactly one
+// door, so every cell is reachable. Across seams the maze may contain loops.
+class ChunkedMaze {
+private:
+    uint64_t worldSeed;
+    Algorithm algorithm;
+    size_t maxChunks;
+
+    // Resident chunks, most recently used at the front of lru.
+    struct CacheEntry {
+        std::unique_ptr<MazeChunk> chunk;
+        std::list<uint64_t>::iterator lruPosition;
+    };
+    std::unordered_map<uint64_t, CacheEntry> cache;
+    std::list<uint64_t> lru;
+    std::unordered_set<uint64_t> pending;  // requested from the worker, not collected yet
+    int32_t prefetchX = 0, prefetchY = 0;  // the area last passed to prefetchAround()
+    int prefetchRadius = -1;
+
+    // Worker thread state, guarded by queueMutex.
+    std::mutex queueMutex;
+    std::condition_variable queueReady;
+    std::deque<uint64_t> requests;
+    std::vector<std::unique_ptr<MazeChunk>> finished;
+    bool stopping = false;
+    std::thread worker;
+
+    static uint64_t chunkKey(int32_t chunkX, int32_t chunkY) {
+        return (static_cast<uint64_t>(static_cast<uint32_t>(chunkX)) << 32) | static_cast<uint32_t>(chunkY);
+    }
+
+    std::unique_ptr<MazeChunk> generateChunk(int32_t chunkX, int32_t chunkY) const;
+    // A chunk that is not recent goes in as least recently used (or not at all when the cache is full).
+    void insert(std::unique_ptr<MazeChunk> chunk, bool recent);
+    void workerLoop();
+
+public:
+    ChunkedMaze(uint64_t worldSeed, Algorithm algorithm, size_t maxChunks);
+    ~ChunkedMaze();
+
+    ChunkedMaze(const ChunkedMaze&) = delete;
+    ChunkedMaze& operator=(const ChunkedMaze&) = delete;
+
+    static int32_t chunkOf(int64_t cell) {
+        return static_cast<int32_t>(cell >= 0 ? cell / CHUNK_SIZE : -((-cell + CHUNK_SIZE - 1) / CHUNK_SIZE));
+    }
+
+    // Which cell along the seam holds the door: the east seam of a chunk (its right column)
+    // or its south seam (its bottom row). A chunk's west and north doors are its neighbors'
+    // east and south doors.
+    int eastDoor(int32_t chunkX, int32_t chunkY) const;
+    int southDoor(int32_t chunkX, int32_t chunkY) const;
+
+    // The chunk at the given chunk coordinates. Loads it synchronously if the worker has not
+    // delivered it yet, and marks it most recently used.
+    const MazeChunk& chunk(int32_t chunkX, int32_t chunkY);
+
+    bool hasWall(int64_t x, int64_t y, Wall wall);
+
+    // Queues every chunk within radius (in chunks) of the given one for background generation.
+    void prefetchAround(int32_t chunkX, int32_t chunkY, int radius);
+
+    // Moves chunks the worker has finished into the cache. Call once per frame. Those still
+    // around the player count as just used; any the player has since moved away from are put
+    // behind every other chunk, so they never push out the ones next to the player.
+    void collectReady();
+
+    uint64_t getSeed() const { return worldSeed; }
+    size_t loadedChunks() const { return cache.size(); }
+    size_t memoryBytes() const;
+};
@@ -0,0 +1,93 @@
+#include "EllerGenerator.h"
+
+using namespace std;
+
+void EllerGenerator::start() {
+    int width = graph.getColumns();
+    row = 0;
+    label.assign(width, -1);
+    nextLabel.assign(width, -1);
+    firstWithLabel.assign(static_cast<size_t>(width) * 2, -1);
+    memberCount.assign(width, 0);
+    downCandidate.assign(width, 0);
+    hasDown.assign(width, 0);
+}
+
+bool EllerGenerator::step() {
+    if (isDone()) {
+        return false;
+    }
+
+    int width = graph.getColumns();
+    int rowStart = row * width;
+    bool lastRow = row == graph.getRows() - 1;
+
+    // Cells with no connection from above start in a set of their own, then cells that share
+    // a label are grouped under the first of them.
+    rowSets.reset(width);
+    for (int x = 0; x < width; ++x) {
+        if (label[x] < 0) {
+            label[x] = width + x;
+        }
+        int& first = firstWithLabel[label[x]];
+        if (first < 0) {
+            first = x;
+        }
+        else {
+            rowSets.unite(first, x);
+        }
+    }
+    for (int x = 0; x < width; ++x) {
+        firstWithLabel[label[x]] = -1;
+    }
+
+    // Randomly join neighbors that are not connected yet. The last row has to join them all.
+    for (int x = 0; x + 1 < width; ++x) {
+        if (rowSets.find(x) != rowSets.find(x + 1) && (lastRow || rng.bounded(2) == 0)) {
+            graph.removeWalls(rowStart + x, rowStart + x + 1);
+            rowSets.unite(x, x + 1);
+        }
+    }
+
+    if (!lastRow) {
+        // Each cell drops down with even odds, and every set must drop down at least once so
+        // it stays connected to the rest of the maze. A reservoir pick chooses the fallback.
+        for (int x = 0; x < width; ++x) {
+            int root = rowSets.find(x);
+            if (rng.bounded(++memberCount[root]) == 0) {
+                downCandidate[root] = x;
+            }
+            nextLabel[x] = -1;
+            if (rng.bounded(2) == 0) {
+                graph.removeWalls(rowStart + x, rowStart + x + width);
+                nextLabel[x] = root;
+                hasDown[root] = 1;
+            }
+        }
+        for (int x = 0; x < width; ++x) {
+            if (memberCount[x] == 0) {
+                continue;  // not a set root
+            }
+            if (!hasDown[x]) {
+                int chosen = downCandidate[x];
+                graph.removeWalls(rowStart + chosen, rowStart + chosen + width);
+                nextLabel[chosen] = x;
+            }
+            memberCount[x] = 0;
+            hasDown[x] = 0;
+        }
+        label.swap(nextLabel);
+    }
+
+    for (int x = 0; x < width; ++x) {
+        graph.setVisited(rowStart + x);
+    }
+    currentNode = rowStart + width - 1;
+    ++row;
+    return true;
+}
+
+size_t EllerGenerator::workingMemoryBytes() const {
+    return (label.capacity() + nextLabel.capacity() + firstWithLabel.capacity() + memberCount.capacity()
+        + downCandidate.capacity()) * sizeof(int) + hasDown.capacity() + rowSets.memoryBytes();
+}
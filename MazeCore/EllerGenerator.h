@@ -0,0 +1,35 @@
+#pragma once
+
+#include "MazeGenerator.h"
+#include "UnionFind.h"
+
+#include <cstdint>
+#include <vector>
+
+// Eller's algorithm: builds the maze one row at a time, remembering only which cells of the
+// current row are already connected. Its bookkeeping is O(width) whatever the height, which
+// makes it the natural fit for streaming mazes row by row. One row per step().
+class EllerGenerator : public MazeGenerator {
+private:
+    int row = 0;
+    // Set label of each cell in the current row. Cells that inherited a connection from the
+    // row above carry the column of that set's root (< width); new cells get width + column.
+    std::vector<int> label;
+    std::vector<int> nextLabel;
+    std::vector<int> firstWithLabel;  // indexed by label, -1 when unused this row
+    std::vector<int> memberCount;     // per set root: members seen so far
+    std::vector<int> downCandidate;   // per set root: member picked to guarantee a way down
+    std::vector<uint8_t> hasDown;
+    UnionFind rowSets;
+
+protected:
+    void start() override;
+
+public:
+    explicit EllerGenerator(Graph& graph) : MazeGenerator(graph) {}
+
+    Algorithm getAlgorithm() const override { return Algorithm::Eller; }
+    bool isDone() const override { return row >= graph.getRows(); }
+    bool step() override;
+    size_t workingMemoryBytes() const override;
+};
@@ -0,0 +1,98 @@
+#include "GameSession.h"
+
+#include <algorithm>
+#include <cmath>
+
+using namespace std;
+
+const DifficultyLevel DIFFICULTY_LEVELS[DIFFICULTY_COUNT] = {
+    { "EASY", 1.5f, 0.66f },
+    { "MEDIUM", 1.0f, 0.33f },
+    { "DIFFICULT", 0.67f, 0.17f }
+};
+
+void calibrateRound(const DifficultyLevel& level, uint32_t solutionLength, float& timeLimit, int& undos) {
+    timeLimit = max(MIN_ROUND_SECONDS, solutionLength * level.secondsPerMove);
+    undos = max(1, static_cast<int>(solutionLength * level.undosPerMove + 0.5f));
+}
+
+GameSession::GameSession(const Graph& graph) : graph(graph) {
+}
+
+void GameSession::reset() {
+    playerX = playerY = 0;
+    trail.clear();
+    undosLeft = 0;
+    ticksLeft = ticksPlayed = 0;
+    timeLimitTicks = 0;
+    state = SessionState::Waiting;
+}
+
+void GameSession::start(float timeLimitSeconds, int undos) {
+    reset();
+    // In a perfect maze the trail is a simple path, so it never outgrows this and move() never allocates
+    trail.reserve(graph.cellCount());
+    undosLeft = undos;
+    timeLimitTicks = static_cast<int>(lround(timeLimitSeconds * TICK_RATE));
+    ticksLeft = timeLimitTicks;
+    state = undosLeft > 0 ? SessionState::Playing : SessionState::OutOfMoves;
+}
+
+bool GameSession::move(Move move) {
+    if (state != SessionState::Playing) {
+        return false;
+    }
+
+    static const Wall WALLS[] = { WALL_TOP, WALL_BOTTOM, WALL_LEFT, WALL_RIGHT };
+    static const int DX[] = { 0, 0, -1, 1 };
+    static const int DY[] = { -1, 1, 0, 0 };
+    int direction = static_cast<int>(move);
+    int current = getCell();
+    if (graph.hasWall(current, WALLS[direction])) {
+        return false;
+    }
+
+    playerX += DX[direction];
+    playerY += DY[direction];
+    int next = getCell();
+    if (!trail.empty() && trail.back() == next) {
+        trail.pop_back();
+        --undosLeft;
+    }
+    else {
+        trail.push_back(current);
+    }
+
+    if (undosLeft <= 0) {
+        state = SessionState::OutOfMoves;
+    }
+    else if (playerX == graph.getColumns() - 1 && playerY == graph.getRows() - 1) {
+        state = SessionState::Won;
+    }
+    return true;
+}
+
+void GameSession::tick() {
+    if (state != SessionState::Playing) {
+        return;
+    }
+    ++ticksPlayed;
+    if (--ticksLeft <= 0) {
+        ticksLeft = 0;
+        state = SessionState::OutOfTime;
+    }
+}
+
+void GameSession::advance(int64_t count) {
+    if (state != SessionState::Playing || count <= 0) {
+        return;
+    }
+    // tick() always counts the tick that runs the clock out, even from a zero time limit
+    int64_t run = min(count, max<int64_t>(ticksLeft, 1));
+    ticksPlayed += run;
+    ticksLeft -= run;
+    if (ticksLeft <= 0) {
+        ticksLeft = 0;
+        state = SessionState::OutOfTime;
+    }
+}
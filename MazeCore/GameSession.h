@@ -0,0 +1,80 @@
+#pragma once
+
+#include "Graph.h"
+
+#include <cstdint>
+#include <vector>
+
+enum class Move : uint8_t { Up, Down, Left, Right };
+
+enum class SessionState : uint8_t {
+    Waiting,     // maze not ready yet; moves are ignored and the clock is stopped
+    Playing,
+    Won,
+    OutOfMoves,  // the undo budget ran out
+    OutOfTime
+};
+
+// One round of the game with no window attached: the player, the undo budget and the countdown.
+// Time only moves in fixed ticks of 1/TICK_RATE s, so a round plays out the same whatever the
+// frame rate, and the same moves on the same ticks always give the same result.
+//
+// Stepping back onto the cell you just came from is an undo: it costs one from the budget, and
+// running the budget down to zero loses the round, as it always has.
+class GameSession {
+private:
+    const Graph& graph;
+    int playerX = 0, playerY = 0;
+    std::vector<int> trail;  // cells behind the player, most recent last
+    int undosLeft = 0;
+    int64_t ticksLeft = 0;
+    int64_t ticksPlayed = 0;
+    int timeLimitTicks = 0;
+    SessionState state = SessionState::Waiting;
+
+public:
+    static const int TICK_RATE = 240;
+
+    explicit GameSession(const Graph& graph);
+
+    // Back to Waiting at the entrance, e.g. while the next maze is being built.
+    void reset();
+
+    // Starts the clock. The maze must be finished.
+    void start(float timeLimitSeconds, int undos);
+
+    // Applies one move if the round is running and no wall is in the way; returns whether the player moved.
+    bool move(Move move);
+
+    // Advances the countdown by one tick.
+    void tick();
+
+    // Same as calling tick() count times, for simulations that skip the ticks between moves.
+    void advance(int64_t count);
+
+    SessionState getState() const { return state; }
+    bool isOver() const { return state != SessionState::Waiting && state != SessionState::Playing; }
+    int getX() const { return playerX; }
+    int getY() const { return playerY; }
+    int getCell() const { return graph.getNode(playerX, playerY); }
+    int getUndosLeft() const { return undosLeft; }
+    int64_t getTicksPlayed() const { return ticksPlayed; }
+    float getSecondsLeft() const { return static_cast<float>(ticksLeft) / TICK_RATE; }
+    float getTimeLimit() const { return static_cast<float>(timeLimitTicks) / TICK_RATE; }
+};
+
+// Time and undo allowance per move of the shortest solution, so a round is as hard as its
+// difficulty says whatever maze it got. On a Prim maze of 20x10 (about 30 moves) these land
+// on the old fixed 45 s / 20, 30 s / 10 and 20 s / 5.
+struct DifficultyLevel {
+    const char* name;
+    float secondsPerMove;
+    float undosPerMove;
+};
+
+const int DIFFICULTY_COUNT = 3;
+extern const DifficultyLevel DIFFICULTY_LEVELS[DIFFICULTY_COUNT];
+const float MIN_ROUND_SECONDS = 10.0f;
+
+// The limits to start() a round with on a maze whose solution is solutionLength moves.
+void calibrateRound(const DifficultyLevel& level, uint32_t solutionLength, float& timeLimit, int& undos);
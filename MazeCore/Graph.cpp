@@ -0,0 +1,65 @@
+#include "Graph.h"
+
+#include <algorithm>
+
+using namespace std;
+
+Graph::Graph(int cols, int rows) : COLUMNS(cols), ROWS(rows),
+    walls(static_cast<size_t>(cols) * rows, ALL_WALLS),
+    visitedBits((static_cast<size_t>(cols) * rows + 63) / 64, 0) {
+}
+
+void Graph::setCarveLogging(bool enabled) {
+    logCarves = enabled;
+    if (enabled) carveLog.reserve(cellCount());
+}
+
+void Graph::removeWalls(int current, int neighbor) {
+    int delta = neighbor - current;
+
+    // Vertical first so a single-column maze (where delta 1 == COLUMNS) is read as a row step.
+    if (delta == COLUMNS) {
+        walls[current] &= ~WALL_BOTTOM;
+        walls[neighbor] &= ~WALL_TOP;
+        if (logCarves) carveLog.push_back(current * 2 + 1);
+    }
+    else if (delta == -COLUMNS) {
+        walls[current] &= ~WALL_TOP;
+        walls[neighbor] &= ~WALL_BOTTOM;
+        if (logCarves) carveLog.push_back(neighbor * 2 + 1);
+    }
+    else if (delta == 1) {
+        walls[current] &= ~WALL_RIGHT;
+        walls[neighbor] &= ~WALL_LEFT;
+        if (logCarves) carveLog.push_back(current * 2);
+    }
+    else if (delta == -1) {
+        walls[current] &= ~WALL_LEFT;
+        walls[neighbor] &= ~WALL_RIGHT;
+        if (logCarves) carveLog.push_back(neighbor * 2);
+    }
+}
+
+void Graph::carveEdge(uint32_t edge) {
+    int cell = static_cast<int>(edge / 2);
+    removeWalls(cell, edge % 2 ? cell + COLUMNS : cell + 1);
+}
+
+void Graph::copyTile(const Graph& tile, int left, int top) {
+    // A tile's outer walls are all closed, like the untouched cells they land on.
+    for (int y = 0; y < tile.ROWS; ++y) {
+        copy_n(tile.walls.begin() + static_cast<size_t>(y) * tile.COLUMNS, tile.COLUMNS,
+            walls.begin() + static_cast<size_t>(top + y) * COLUMNS + left);
+    }
+}
+
+void Graph::reset() {
+    fill(walls.begin(), walls.end(), ALL_WALLS);
+    fill(visitedBits.begin(), visitedBits.end(), 0);
+    carveLog.clear();
+    ++epoch;
+}
+
+size_t Graph::memoryBytes() const {
+    return walls.capacity() + visitedBits.capacity() * sizeof(uint64_t) + carveLog.capacity() * sizeof(uint32_t);
+}
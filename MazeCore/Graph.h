@@ -0,0 +1,86 @@
+#pragma once
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+
+// Wall bits for a cell, in the same Top, Right, Bottom, Left order the old Node::walls[] used.
+enum Wall : uint8_t {
+    WALL_TOP = 1 << 0,
+    WALL_RIGHT = 1 << 1,
+    WALL_BOTTOM = 1 << 2,
+    WALL_LEFT = 1 << 3,
+    ALL_WALLS = WALL_TOP | WALL_RIGHT | WALL_BOTTOM | WALL_LEFT
+};
+
+// Cells are addressed by their row-major index (y * COLUMNS + x); -1 means "no cell".
+// Walls take one byte per cell and visited flags one bit per cell, so a cell costs
+// 1.125 bytes instead of the 64 bytes (plus two malloc headers) a map entry and a heap Node used to.
+class Graph {
+private:
+    int COLUMNS, ROWS;
+    std::vector<uint8_t> walls;
+    std::vector<uint64_t> visitedBits;
+    std::vector<uint32_t> carveLog;
+    bool logCarves = false;
+    unsigned epoch = 0;
+
+public:
+    Graph(int cols, int rows);
+
+    int getColumns() const { return COLUMNS; }
+    int getRows() const { return ROWS; }
+    int cellCount() const { return COLUMNS * ROWS; }
+
+    int getNode(int x, int y) const {
+        if (x >= 0 && x < COLUMNS && y >= 0 && y < ROWS) {
+            return y * COLUMNS + x;
+        }
+        return -1;
+    }
+
+    int cellX(int cell) const { return cell % COLUMNS; }
+    int cellY(int cell) const { return cell / COLUMNS; }
+
+    // Writes the in-bounds neighbors of a cell (left, right, up, down) and returns how many there are.
+    int getNeighbors(int cell, int out[4]) const {
+        int x = cell % COLUMNS;
+        int count = 0;
+        if (x > 0) out[count++] = cell - 1;
+        if (x < COLUMNS - 1) out[count++] = cell + 1;
+        if (cell >= COLUMNS) out[count++] = cell - COLUMNS;
+        if (cell < cellCount() - COLUMNS) out[count++] = cell + COLUMNS;
+        return count;
+    }
+
+    bool hasWall(int cell, Wall wall) const { return (walls[cell] & wall) != 0; }
+    uint8_t getWalls(int cell) const { return walls[cell]; }
+    const uint8_t* wallBytes() const { return walls.data(); }
+
+    // Every wall removal is recorded as an edge id: cell * 2 for the wall to its right,
+    // cell * 2 + 1 for the wall below it. Renderers replay the log to patch only what changed.
+    // Logging reserves room for a whole spanning tree, so the log's storage does not move
+    // while a maze is carved and entries already written can be read from another thread.
+    void setCarveLogging(bool enabled);
+    const std::vector<uint32_t>& getCarveLog() const { return carveLog; }
+
+    // Removes the wall an edge id from a carve log stands for, e.g. to mirror another graph.
+    void carveEdge(uint32_t edge);
+
+    // Bumped by reset() so observers know the carve log started over.
+    unsigned getEpoch() const { return epoch; }
+
+    bool isVisited(int cell) const { return (visitedBits[cell >> 6] >> (cell & 63)) & 1; }
+    void setVisited(int cell) { visitedBits[cell >> 6] |= uint64_t(1) << (cell & 63); }
+
+    void removeWalls(int current, int neighbor);
+    void reset();
+
+    // Copies a finished maze into the rectangle with its top left cell at (left, top), which
+    // must be untouched since reset(). Only that rectangle's wall bytes are written, so tiles
+    // that do not overlap can be copied from different threads at once. The carve log is not told.
+    void copyTile(const Graph& tile, int left, int top);
+
+    // Bytes held by the grid itself (walls, visited bits and carve log).
+    size_t memoryBytes() const;
+};
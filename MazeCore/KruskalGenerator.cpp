@@ -0,0 +1,43 @@
+#include "KruskalGenerator.h"
+
+#include <utility>
+
+using namespace std;
+
+void KruskalGenerator::start() {
+    int columns = graph.getColumns(), rows = graph.getRows();
+
+    edges.clear();
+    edges.reserve(static_cast<size_t>(graph.cellCount()) * 2);
+    for (int y = 0; y < rows; ++y) {
+        for (int x = 0; x < columns; ++x) {
+            uint32_t cell = y * columns + x;
+            if (x < columns - 1) edges.push_back(cell * 2);
+            if (y < rows - 1) edges.push_back(cell * 2 + 1);
+        }
+    }
+    remainingEdges = edges.size();
+    carved = 0;
+    cells.reset(graph.cellCount());
+}
+
+bool KruskalGenerator::step() {
+    while (!isDone()) {
+        // Fisher-Yates, one draw at a time: take a random edge from the unshuffled prefix.
+        size_t pick = rng.bounded(static_cast<uint32_t>(remainingEdges));
+        uint32_t edge = edges[pick];
+        swap(edges[pick], edges[--remainingEdges]);
+
+        int cell = edge >> 1;
+        int neighbor = (edge & 1) ? cell + graph.getColumns() : cell + 1;
+        if (cells.unite(cell, neighbor)) {
+            graph.removeWalls(cell, neighbor);
+            graph.setVisited(cell);
+            graph.setVisited(neighbor);
+            currentNode = neighbor;
+            ++carved;
+            return true;
+        }
+    }
+    return false;
+}
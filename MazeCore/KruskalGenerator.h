@@ -0,0 +1,29 @@
+#pragma once
+
+#include "MazeGenerator.h"
+#include "UnionFind.h"
+
+#include <cstdint>
+#include <vector>
+
+// Randomized Kruskal's algorithm: visits every interior wall in random order and knocks it
+// down when the cells on either side are not yet connected. The shuffle is done lazily, one
+// pick per wall, so reset() stays O(cells) and each step() carves exactly one cell.
+class KruskalGenerator : public MazeGenerator {
+private:
+    std::vector<uint32_t> edges;  // edge ids as in Graph's carve log: cell * 2 + (0 right, 1 bottom)
+    size_t remainingEdges = 0;
+    int carved = 0;
+    UnionFind cells;
+
+protected:
+    void start() override;
+
+public:
+    explicit KruskalGenerator(Graph& graph) : MazeGenerator(graph) {}
+
+    Algorithm getAlgorithm() const override { return Algorithm::Kruskal; }
+    bool isDone() const override { return carved >= graph.cellCount() - 1 || remainingEdges == 0; }
+    bool step() override;
+    size_t workingMemoryBytes() const override { return edges.capacity() * sizeof(uint32_t) + cells.memoryBytes(); }
+};
@@ -0,0 +1,252 @@
+#include "MazeFile.h"
+
+#include "ByteIO.h"
+#include "WallPlanes.h"
+
+#include <algorithm>
+#include <cstring>
+
+using namespace std;
+
+namespace {
+    const char MAZE_MAGIC[4] = { 'M', 'Q', 'M', 'Z' };
+    const char PACK_MAGIC[4] = { 'M', 'Q', 'P', 'K' };
+    const uint16_t PACK_VERSION = 1;
+    const size_t PACK_HEADER_SIZE = 16;
+
+    const uint8_t* wallBits(const uint8_t* data) {
+        return data + getLittleEndian(data + 6, 2);
+    }
+
+    unsigned cellBits(const uint8_t* walls, size_t cell) {
+        return (walls[cell >> 2] >> ((cell & 3) * 2)) & 3;
+    }
+
+    // The cells' 2-bit fields from bit offset on, as many as fit in 64 bits (at least 28),
+    // without reading past end. Assembled a byte at a time, so it reads the same on any host.
+    uint64_t readCellBits(const uint8_t* walls, const uint8_t* end, size_t bitOffset) {
+        const uint8_t* from = walls + bitOffset / 8;
+        uint64_t bits = getLittleEndian(from, static_cast<int>(min<size_t>(sizeof(bits), end - from)));
+        return bits >> (bitOffset % 8);
+    }
+
+    // The even bits of 32 moved down into 16 (the odd ones are dropped).
+    uint64_t evenBits(uint64_t bits) {
+        bits &= 0x55555555;
+        bits = (bits | (bits >> 1)) & 0x33333333;
+        bits = (bits | (bits >> 2)) & 0x0F0F0F0F;
+        bits = (bits | (bits >> 4)) & 0x00FF00FF;
+        return (bits | (bits >> 8)) & 0x0000FFFF;
+    }
+
+    // Reads the header and checks the walls are a perfect maze: a closed border, then the
+    // walls as bit planes, 16 cells at a time, for WallPlanes to count and flood.
+    bool checkMaze(const uint8_t* data, size_t size, MazeInfo& info) {
+        if (!readMazeInfo(data, size, info)) {
+            return false;
+        }
+        const uint8_t* walls = wallBits(data);
+        const uint8_t* end = data + size;
+        size_t columns = info.width, rows = info.height;
+        for (size_t y = 0; y < rows; ++y) {
+            if (!(cellBits(walls, y * columns + columns - 1) & 1)) {
+                return false;
+            }
+        }
+        for (size_t x = 0; x < columns; ++x) {
+            if (!(cellBits(walls, (rows - 1) * columns + x) & 2)) {
+                return false;
+            }
+        }
+
+        WallPlanes planes;
+        planes.reset(info.width, info.height);
+        for (size_t y = 0; y < rows; ++y) {
+            for (size_t word = 0; word * 64 < columns; ++word) {
+                uint64_t openRight = 0, openDown = 0;
+                for (size_t x = word * 64; x < min(columns, word * 64 + 64); x += 16) {
+                    size_t cells = min<size_t>(16, columns - x);
+                    uint64_t bits = readCellBits(walls, end, (y * columns + x) * 2);
+                    uint64_t mask = (uint64_t(1) << cells) - 1;
+                    openRight |= (~evenBits(bits) & mask) << (x % 64);
+                    openDown |= (~evenBits(bits >> 1) & mask) << (x % 64);
+                }
+                planes.setWord(static_cast<int>(y), word, openRight, openDown);
+            }
+        }
+        return planes.check().perfect;
+    }
+
+    template <typename OpenEdge>
+    void forEachOpenEdge(const uint8_t* data, const MazeInfo& info, OpenEdge open) {
+        const uint8_t* walls = wallBits(data);
+        size_t cells = static_cast<size_t>(info.width) * info.height;
+        for (size_t cell = 0; cell < cells; ++cell) {
+            unsigned bits = cellBits(walls, cell);
+            if (!(bits & 1)) open(static_cast<uint32_t>(cell * 2));
+            if (!(bits & 2)) open(static_cast<uint32_t>(cell * 2 + 1));
+        }
+    }
+}
+
+size_t mazeFileSize(int width, int height) {
+    return MAZE_FILE_HEADER_SIZE + (static_cast<size_t>(width) * height + 3) / 4;
+}
+
+void appendMazeFile(string& out, const Graph& graph, const MazeInfo& info) {
+    int columns = graph.getColumns(), rows = graph.getRows();
+    out.reserve(out.size() + mazeFileSize(columns, rows));
+    out.append(MAZE_MAGIC, sizeof(MAZE_MAGIC));
+    putLittleEndian(out, MAZE_FILE_VERSION, 2);
+    putLittleEndian(out, MAZE_FILE_HEADER_SIZE, 2);
+    putLittleEndian(out, static_cast<uint32_t>(columns), 4);
+    putLittleEndian(out, static_cast<uint32_t>(rows), 4);
+    putLittleEndian(out, info.seed, 8);
+    putLittleEndian(out, static_cast<uint8_t>(info.algorithm), 1);
+    putLittleEndian(out, 0, 3);
+    putLittleEndian(out, info.solutionLength, 4);
+
+    int cells = graph.cellCount();
+    for (int first = 0; first < cells; first += 4) {
+        unsigned packed = 0;
+        for (int cell = first; cell < min(cells, first + 4); ++cell) {
+            unsigned bits = (graph.hasWall(cell, WALL_RIGHT) ? 1 : 0) | (graph.hasWall(cell, WALL_BOTTOM) ? 2 : 0);
+            packed |= bits << ((cell - first) * 2);
+        }
+        out += static_cast<char>(packed);
+    }
+}
+
+bool readMazeInfo(const uint8_t* data, size_t size, MazeInfo& info) {
+    if (size < MAZE_FILE_HEADER_SIZE || memcmp(data, MAZE_MAGIC, sizeof(MAZE_MAGIC)) != 0) {
+        return false;
+    }
+    uint64_t version = getLittleEndian(data + 4, 2);
+    uint64_t headerSize = getLittleEndian(data + 6, 2);
+    uint64_t width = getLittleEndian(data + 8, 4);
+    uint64_t height = getLittleEndian(data + 12, 4);
+    uint64_t algorithm = data[24];
+    // A newer version only adds header fields; the walls start at headerSize whatever it is
+    if (version < MAZE_FILE_VERSION || headerSize < MAZE_FILE_HEADER_SIZE || width == 0 || height == 0
+        || width * height > INT32_MAX || algorithm >= ALGORITHM_COUNT) {
+        return false;
+    }
+    if (size < headerSize + (width * height + 3) / 4) {
+        return false;
+    }
+
+    info.width = static_cast<int>(width);
+    info.height = static_cast<int>(height);
+    info.seed = getLittleEndian(data + 16, 8);
+    info.algorithm = static_cast<Algorithm>(algorithm);
+    info.solutionLength = static_cast<uint32_t>(getLittleEndian(data + 28, 4));
+    return true;
+}
+
+bool loadMaze(const uint8_t* data, size_t size, Graph& graph) {
+    MazeInfo info;
+    if (!checkMaze(data, size, info) || info.width != graph.getColumns() || info.height != graph.getRows()) {
+        return false;
+    }
+    graph.reset();
+    forEachOpenEdge(data, info, [&](uint32_t edge) { graph.carveEdge(edge); });
+    return true;
+}
+
+bool readMazeEdges(const uint8_t* data, size_t size, vector<uint32_t>& edges) {
+    MazeInfo info;
+    edges.clear();
+    if (!checkMaze(data, size, info)) {
+        return false;
+    }
+    edges.reserve(static_cast<size_t>(info.width) * info.height);
+    forEachOpenEdge(data, info, [&](uint32_t edge) { edges.push_back(edge); });
+    return true;
+}
+
+uint64_t MazePack::offset(size_t index) const {
+    if (single) {
+        return index == 0 ? 0 : file.size();
+    }
+    return getLittleEndian(file.data() + PACK_HEADER_SIZE + index * 8, 8);
+}
+
+bool MazePack::open(const string& path) {
+    count = 0;
+    if (!file.open(path)) {
+        return false;
+    }
+    const uint8_t* data = file.data();
+    size_t size = file.size();
+
+    MazeInfo info;
+    single = readMazeInfo(data, size, info);
+    if (single) {
+        count = 1;
+        return true;
+    }
+
+    if (size < PACK_HEADER_SIZE || memcmp(data, PACK_MAGIC, sizeof(PACK_MAGIC)) != 0
+        || getLittleEndian(data + 4, 2) != PACK_VERSION) {
+        file.close();
+        return false;
+    }
+    uint64_t mazes = getLittleEndian(data + 8, 4);
+    if (size < PACK_HEADER_SIZE + (mazes + 1) * 8) {
+        file.close();
+        return false;
+    }
+    count = static_cast<uint32_t>(mazes);
+
+    // Only the table is checked here; each maze's own header is checked when it is read.
+    for (size_t i = 0; i < count; ++i) {
+        if (offset(i) > offset(i + 1) || offset(i + 1) > size) {
+            count = 0;
+            file.close();
+            return false;
+        }
+    }
+    return true;
+}
+
+bool MazePackWriter::open(const string& path, uint32_t mazeCount) {
+    out.open(path, ios::binary | ios::trunc);
+    if (!out) {
+        return false;
+    }
+    count = mazeCount;
+    offsets.clear();
+    offsets.reserve(static_cast<size_t>(count) + 1);
+
+    // The table is written as zeros now and filled in by close().
+    string header(PACK_MAGIC, sizeof(PACK_MAGIC));
+    putLittleEndian(header, PACK_VERSION, 2);
+    putLittleEndian(header, 0, 2);
+    putLittleEndian(header, count, 4);
+    putLittleEndian(header, 0, 4);
+    header.append((static_cast<size_t>(count) + 1) * 8, '\0');
+    out.write(header.data(), header.size());
+    offsets.push_back(header.size());
+    return static_cast<bool>(out);
+}
+
+bool MazePackWriter::add(const string& mazeFile) {
+    if (offsets.size() > count) {
+        return false;
+    }
+    out.write(mazeFile.data(), mazeFile.size());
+    offsets.push_back(offsets.back() + mazeFile.size());
+    return static_cast<bool>(out);
+}
+
+bool MazePackWriter::close() {
+    bool complete = offsets.size() == static_cast<size_t>(count) + 1;
+    string table;
+    for (uint64_t offset : offsets) {
+        putLittleEndian(table, offset, 8);
+    }
+    out.seekp(PACK_HEADER_SIZE);
+    out.write(table.data(), table.size());
+    out.close();
+    return complete && !out.fail();
+}
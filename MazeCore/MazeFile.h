@@ -0,0 +1,97 @@
+#pragma once
+
+#include "Graph.h"
+#include "MappedFile.h"
+#include "MazeGenerator.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Binary maze file ("MQMZ"), little-endian:
+//
+//    0  "MQMZ"                 4  version (u16)          6  header size (u16)
+//    8  width (u32)           12  height (u32)          16  seed (u64)
+//   24  algorithm (u8), 3 reserved bytes                28  solution length (u32)
+//   32  walls
+//
+// Walls take 2 bits per cell in row-major order, four cells to a byte from the low bits up:
+// bit 0 is the wall to the cell's right, bit 1 the wall below it (the carve log's edge ids).
+// Left and top walls follow from the neighbours and the outer border is always closed, so a
+// 4096x4096 maze is 4 MB. Readers skip header bytes past the fields they know, so a later
+// version can add fields without breaking them: any version from 1 up is read, and a version
+// that changes the layout of these fields or the walls needs a new magic.
+const uint16_t MAZE_FILE_VERSION = 1;
+const size_t MAZE_FILE_HEADER_SIZE = 32;
+
+// What a saved maze says about itself besides its walls.
+struct MazeInfo {
+    int width = 0, height = 0;
+    uint64_t seed = 0;
+    Algorithm algorithm = Algorithm::Prim;
+    uint32_t solutionLength = 0;  // moves from the entrance (top left) to the treasure (bottom right)
+};
+
+size_t mazeFileSize(int width, int height);
+
+// Appends graph as a maze file. info's width and height are taken from the graph.
+void appendMazeFile(std::string& out, const Graph& graph, const MazeInfo& info);
+
+// Reads and checks the header. Returns false unless data holds a whole maze file of version 1 or later.
+bool readMazeInfo(const uint8_t* data, size_t size, MazeInfo& info);
+
+// Replaces graph's maze with the saved one; graph must have the saved dimensions. Walls are
+// opened through carveEdge(), so the carve log and everything replaying it follow. Returns
+// false, leaving graph untouched, for a damaged file or a maze that is not perfect (checked
+// on the file's bits with WallPlanes before anything is carved).
+bool loadMaze(const uint8_t* data, size_t size, Graph& graph);
+
+// The edge ids of every open wall in the file, in file order, for carving it gradually.
+bool readMazeEdges(const uint8_t* data, size_t size, std::vector<uint32_t>& edges);
+
+// Level pack ("MQPK"), little-endian:
+//
+//    0  "MQPK"   4  version (u16)   6  reserved (u16)   8  maze count (u32)   12  reserved (u32)
+//   16  count + 1 offsets (u64) from the start of the file; maze i is [offset i, offset i + 1)
+//
+// followed by the maze files themselves, back to back. A pack is read through a memory
+// mapping: opening it touches only the header and offset table, and a maze's bytes are used
+// where they lie, so any maze of a pack of thousands is as quick to reach as the first.
+class MazePack {
+private:
+    MappedFile file;
+    uint32_t count = 0;
+    bool single = false;  // a plain maze file, opened as a pack of one
+
+    uint64_t offset(size_t index) const;
+
+public:
+    // Opens a pack, or a single maze file as a pack of one. Returns false if it is neither.
+    bool open(const std::string& path);
+
+    size_t mazeCount() const { return count; }
+
+    // The file bytes of maze index, straight from the mapping; valid while the pack is open.
+    const uint8_t* mazeData(size_t index) const { return file.data() + offset(index); }
+    size_t mazeSize(size_t index) const { return static_cast<size_t>(offset(index + 1) - offset(index)); }
+};
+
+// Streams maze files into a pack whose maze count is known up front. The offset table is
+// filled in by close(), once every maze's size is known.
+class MazePackWriter {
+private:
+    std::ofstream out;
+    std::vector<uint64_t> offsets;
+    uint32_t count = 0;
+
+public:
+    bool open(const std::string& path, uint32_t mazeCount);
+
+    // Adds one maze file, as made by appendMazeFile().
+    bool add(const std::string& mazeFile);
+
+    // Writes the offset table. Returns false if fewer mazes than promised were added or writing failed.
+    bool close();
+};
@@ -0,0 +1,58 @@
+#include "MazeGenerator.h"
+
+#include "BacktrackerGenerator.h"
+#include "EllerGenerator.h"
+#include "KruskalGenerator.h"
+#include "PrimGenerator.h"
+#include "WilsonGenerator.h"
+
+#include <cctype>
+
+using namespace std;
+
+const char* algorithmName(Algorithm algorithm) {
+    switch (algorithm) {
+    case Algorithm::Prim: return "PRIM";
+    case Algorithm::Kruskal: return "KRUSKAL";
+    case Algorithm::Wilson: return "WILSON";
+    case Algorithm::Eller: return "ELLER";
+    case Algorithm::Backtracker: return "BACKTRACKER";
+    }
+    return "UNKNOWN";
+}
+
+bool parseAlgorithm(const string& name, Algorithm& algorithm) {
+    string upper = name;
+    for (char& c : upper) {
+        c = static_cast<char>(toupper(static_cast<unsigned char>(c)));
+    }
+
+    for (int i = 0; i < ALGORITHM_COUNT; ++i) {
+        if (upper == algorithmName(static_cast<Algorithm>(i))) {
+            algorithm = static_cast<Algorithm>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+void MazeGenerator::reset(uint64_t newSeed) {
+    seed = newSeed;
+    rng.seed(seed);
+    graph.reset();
+    currentNode = -1;
+    start();
+}
+
+unique_ptr<MazeGenerator> makeGenerator(Algorithm algorithm, Graph& graph, uint64_t seed) {
+    unique_ptr<MazeGenerator> generator;
+    switch (algorithm) {
+    case Algorithm::Prim: generator.reset(new PrimGenerator(graph)); break;
+    case Algorithm::Kruskal: generator.reset(new KruskalGenerator(graph)); break;
+    case Algorithm::Wilson: generator.reset(new WilsonGenerator(graph)); break;
+    case Algorithm::Eller: generator.reset(new EllerGenerator(graph)); break;
+    case Algorithm::Backtracker: generator.reset(new BacktrackerGenerator(graph)); break;
+    }
+    generator->reset(seed);
+    return generator;
+}
@@ -0,0 +1,59 @@
+#pragma once
+
+#include "Graph.h"
+#include "Rng.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+
+enum class Algorithm { Prim, Kruskal, Wilson, Eller, Backtracker };
+
+const int ALGORITHM_COUNT = 5;
+
+// Upper-case name as shown in the menu ("PRIM", "KRUSKAL", ...).
+const char* algorithmName(Algorithm algorithm);
+
+// Accepts the names above in any case. Returns false for anything else.
+bool parseAlgorithm(const std::string& name, Algorithm& algorithm);
+
+// A maze generation algorithm that carves walls out of a Graph a little at a time, so the
+// game can animate it or spread it over several frames. The generator only draws random
+// numbers inside step(), so a seed always produces the same maze however it is driven.
+class MazeGenerator {
+protected:
+    Graph& graph;
+    Rng rng;
+    uint64_t seed = 0;
+    int currentNode = -1;
+
+    // Sets up algorithm state on a freshly reset graph.
+    virtual void start() = 0;
+
+public:
+    explicit MazeGenerator(Graph& graph) : graph(graph) {}
+    virtual ~MazeGenerator() = default;
+
+    // Clears the maze and starts over. The same seed always carves the same maze.
+    void reset(uint64_t newSeed);
+
+    virtual Algorithm getAlgorithm() const = 0;
+    virtual bool isDone() const = 0;
+
+    // Does one unit of work (usually carving one cell). Returns false once the maze is complete.
+    virtual bool step() = 0;
+
+    // Bytes of bookkeeping the algorithm holds on top of the Graph. Containers never shrink
+    // during a run, so reading this once generation is done gives the peak.
+    virtual size_t workingMemoryBytes() const = 0;
+
+    uint64_t getSeed() const { return seed; }
+    Graph& getGraph() const { return graph; }
+
+    // Cell the algorithm last worked on, for the carving cursor.
+    int getCurrentNode() const { return currentNode; }
+};
+
+// Builds a generator for the algorithm and resets it with the seed.
+std::unique_ptr<MazeGenerator> makeGenerator(Algorithm algorithm, Graph& graph, uint64_t seed);
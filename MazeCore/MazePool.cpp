@@ -0,0 +1,145 @@
+#include "MazePool.h"
+
+#include "Rng.h"
+#include "WallPlanes.h"
+
+#include <utility>
+
+using namespace std;
+
+namespace {
+    // Steps between checks for a pause or shutdown: well under a millisecond of generation.
+    const int STEP_BATCH = 4096;
+}
+
+MazePool::MazePool(int width, int height, uint64_t baseSeed, size_t depth)
+    : width(width), height(height), baseSeed(baseSeed), depth(depth) {
+    worker = thread(&MazePool::workerLoop, this);
+}
+
+MazePool::~MazePool() {
+    {
+        lock_guard<mutex> lock(poolMutex);
+        stopping = true;
+    }
+    poolChanged.notify_all();
+    worker.join();
+}
+
+void MazePool::prepare(Algorithm algorithm) {
+    {
+        lock_guard<mutex> lock(poolMutex);
+        wanted[static_cast<int>(algorithm)] = true;
+        preferred = algorithm;
+    }
+    poolChanged.notify_all();
+}
+
+bool MazePool::take(Algorithm algorithm, PooledMaze& maze) {
+    {
+        lock_guard<mutex> lock(poolMutex);
+        wanted[static_cast<int>(algorithm)] = true;
+        preferred = algorithm;
+        deque<PooledMaze>& queue = ready[static_cast<int>(algorithm)];
+        if (queue.empty()) {
+            return false;
+        }
+        maze = move(queue.front());
+        queue.pop_front();
+    }
+    poolChanged.notify_all();
+    return true;
+}
+
+void MazePool::setPaused(bool pause) {
+    {
+        lock_guard<mutex> lock(poolMutex);
+        if (paused == pause) {
+            return;
+        }
+        paused = pause;
+    }
+    poolChanged.notify_all();
+}
+
+size_t MazePool::readyCount(Algorithm algorithm) {
+    lock_guard<mutex> lock(poolMutex);
+    return ready[static_cast<int>(algorithm)].size();
+}
+
+size_t MazePool::rejectedCount() {
+    lock_guard<mutex> lock(poolMutex);
+    return rejected;
+}
+
+bool MazePool::findWork(Algorithm& algorithm) const {
+    if (paused) {
+        return false;
+    }
+    if (ready[static_cast<int>(preferred)].size() < depth) {
+        algorithm = preferred;
+        return true;
+    }
+    for (int i = 0; i < ALGORITHM_COUNT; ++i) {
+        if (wanted[i] && ready[i].size() < depth) {
+            algorithm = static_cast<Algorithm>(i);
+            return true;
+        }
+    }
+    return false;
+}
+
+void MazePool::workerLoop() {
+    // One graph for every maze, and one generator per algorithm, reused from maze to maze.
+    Graph graph(width, height);
+    graph.setCarveLogging(true);
+    unique_ptr<MazeGenerator> generators[ALGORITHM_COUNT];
+    WallPlanes planes;
+
+    unique_lock<mutex> lock(poolMutex);
+    while (true) {
+        Algorithm algorithm = Algorithm::Prim;
+        poolChanged.wait(lock, [&] { return stopping || findWork(algorithm); });
+        if (stopping) {
+            return;
+        }
+        uint64_t seed = deriveSeed(baseSeed, made++);
+        lock.unlock();
+
+        unique_ptr<MazeGenerator>& generator = generators[static_cast<int>(algorithm)];
+        if (!generator) {
+            generator = makeGenerator(algorithm, graph, seed);
+        }
+        else {
+            generator->reset(seed);
+        }
+        while (!generator->isDone()) {
+            for (int i = 0; i < STEP_BATCH && !generator->isDone(); ++i) {
+                generator->step();
+            }
+            // Paused mid-maze: wait, then carry on with the same maze
+            lock.lock();
+            poolChanged.wait(lock, [&] { return stopping || !paused; });
+            if (stopping) {
+                return;
+            }
+            lock.unlock();
+        }
+
+        // Checked here, off the game's thread, so a pooled maze is known perfect in any build.
+        // One that is not is dropped and the next seed is tried.
+        if (!validateMaze(graph, planes).perfect) {
+            lock.lock();
+            ++rejected;
+            continue;
+        }
+
+        PooledMaze maze;
+        maze.seed = seed;
+        maze.algorithm = algorithm;
+        maze.carveLog = graph.getCarveLog();
+
+        lock.lock();
+        ready[static_cast<int>(algorithm)].push_back(move(maze));
+    }
+}
@@ -0,0 +1,77 @@
+#pragma once
+
+#include "Graph.h"
+#include "MazeGenerator.h"
+
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// A maze built ahead of time: what it was generated from, and the walls it opened in the order
+// they were carved. SavedMazeGenerator plays that order back, so the maze can be put in place in
+// one go or carved again as the usual animation.
+struct PooledMaze {
+    uint64_t seed = 0;
+    Algorithm algorithm = Algorithm::Prim;
+    std::vector<uint32_t> carveLog;
+};
+
+// Keeps mazes of one size ready on a background thread, so a new round does not wait for
+// generation. Up to depth mazes are kept for each algorithm asked for with prepare(). Maze i
+// is built from deriveSeed(baseSeed, i), so any of them can be regenerated from its seed.
+// A ready maze costs 4 bytes per cell. Every maze is validated (WallPlanes.h) before it is
+// offered, which costs the worker about a tenth of generating it.
+//
+// setPaused() holds the worker at its next batch of steps, for while the game is building or
+// solving a maze itself and wants the core.
+class MazePool {
+private:
+    int width, height;
+    uint64_t baseSeed;
+    size_t depth;
+
+    // Worker thread state, guarded by poolMutex.
+    std::mutex poolMutex;
+    std::condition_variable poolChanged;
+    std::deque<PooledMaze> ready[ALGORITHM_COUNT];
+    bool wanted[ALGORITHM_COUNT] = {};
+    Algorithm preferred = Algorithm::Prim;  // filled first: the one asked for last
+    bool paused = false;
+    uint64_t made = 0;
+    size_t rejected = 0;
+    bool stopping = false;
+    std::thread worker;
+
+    bool findWork(Algorithm& algorithm) const;
+    void workerLoop();
+
+public:
+    static const size_t DEFAULT_DEPTH = 2;
+
+    MazePool(int width, int height, uint64_t baseSeed, size_t depth = DEFAULT_DEPTH);
+    ~MazePool();
+
+    MazePool(const MazePool&) = delete;
+    MazePool& operator=(const MazePool&) = delete;
+
+    // Keeps mazes of algorithm ready from now on, building them before any other algorithm's.
+    void prepare(Algorithm algorithm);
+
+    // Moves a ready maze of algorithm into maze and returns true, or returns false straight
+    // away if none is ready. The pool then builds a replacement.
+    bool take(Algorithm algorithm, PooledMaze& maze);
+
+    void setPaused(bool pause);
+
+    size_t readyCount(Algorithm algorithm);
+
+    // Mazes dropped for not being perfect: nonzero means a generator is broken.
+    size_t rejectedCount();
+    int getColumns() const { return width; }
+    int getRows() const { return height; }
+};
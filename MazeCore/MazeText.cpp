@@ -0,0 +1,35 @@
+#include "MazeText.h"
+
+#include <ostream>
+
+using namespace std;
+
+void appendMazeText(string& out, const Graph& graph) {
+    int columns = graph.getColumns(), rows = graph.getRows();
+    out.reserve(out.size() + static_cast<size_t>(2 * rows + 1) * (3 * columns + 2));
+
+    // Top border
+    for (int x = 0; x < columns; ++x) out += "+--";
+    out += "+\n";
+
+    for (int y = 0; y < rows; ++y) {
+        out += '|';
+        for (int x = 0; x < columns; ++x) {
+            out += "  ";
+            out += graph.hasWall(y * columns + x, WALL_RIGHT) ? '|' : ' ';
+        }
+        out += '\n';
+
+        out += '+';
+        for (int x = 0; x < columns; ++x) {
+            out += graph.hasWall(y * columns + x, WALL_BOTTOM) ? "--+" : "  +";
+        }
+        out += '\n';
+    }
+}
+
+void writeMazeText(ostream& out, const Graph& graph) {
+    string text;
+    appendMazeText(text, graph);
+    out << text;
+}
@@ -0,0 +1,11 @@
+#pragma once
+
+#include "Graph.h"
+
+#include <iosfwd>
+#include <string>
+
+// Plain-text maze dump: '+' at every corner, "--" for a horizontal wall, '|' for a vertical
+// one. A W x H maze becomes 2H + 1 lines of 3W + 1 characters.
+void appendMazeText(std::string& out, const Graph& graph);
+void writeMazeText(std::ostream& out, const Graph& graph);
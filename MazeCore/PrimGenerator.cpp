@@ -0,0 +1,50 @@
+#include "PrimGenerator.h"
+
+using namespace std;
+
+void PrimGenerator::start() {
+    frontier.reset(graph.cellCount());
+    currentNode = graph.getNode(0, 0);
+    graph.setVisited(currentNode);
+
+    int neighbors[4];
+    int count = graph.getNeighbors(currentNode, neighbors);
+    for (int i = 0; i < count; ++i) {
+        frontier.add(neighbors[i]);
+    }
+}
+
+bool PrimGenerator::step() {
+    if (frontier.empty()) {
+        return false;
+    }
+
+    currentNode = frontier.removeAt(rng.bounded(frontier.size()));
+
+    // Sort the neighbours, in getNeighbors() order, into carved ones and ones neither carved
+    // nor queued. Which list a neighbour joins is random, so it is counted rather than branched on.
+    int columns = graph.getColumns();
+    int x = graph.cellX(currentNode);
+    const int candidates[4] = { currentNode - 1, currentNode + 1, currentNode - columns, currentNode + columns };
+    const bool inside[4] = { x > 0, x < columns - 1, currentNode >= columns, currentNode < graph.cellCount() - columns };
+    int carved[4], untouched[4];
+    int carvedCount = 0, untouchedCount = 0;
+    for (int i = 0; i < 4; ++i) {
+        int neighbor = inside[i] ? candidates[i] : currentNode;
+        bool visited = graph.isVisited(neighbor);
+        carved[carvedCount] = neighbor;
+        carvedCount += inside[i] & visited;
+        untouched[untouchedCount] = neighbor;
+        untouchedCount += inside[i] & !visited & !frontier.contains(neighbor);
+    }
+
+    // Every frontier cell was queued next to a carved one
+    if (carvedCount > 0) {
+        graph.removeWalls(currentNode, carved[rng.bounded(carvedCount)]);
+        graph.setVisited(currentNode);
+        for (int i = 0; i < untouchedCount; ++i) {
+            frontier.add(untouched[i]);
+        }
+    }
+    return true;
+}
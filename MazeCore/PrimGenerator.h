@@ -0,0 +1,61 @@
+#pragma once
+
+#include "MazeGenerator.h"
+
+#include <cstdint>
+#include <vector>
+
+// Cells adjacent to the carved region that Prim's algorithm can grow into next.
+// An in-frontier bit per cell makes membership O(1), and removal swaps the last
+// entry into the hole so extracting a random cell is O(1) as well.
+class Frontier {
+private:
+    std::vector<int> cells;
+    std::vector<uint64_t> inFrontierBits;
+
+public:
+    void reset(int cellCount) {
+        cells.clear();
+        inFrontierBits.assign((static_cast<size_t>(cellCount) + 63) / 64, 0);
+    }
+
+    bool empty() const { return cells.empty(); }
+    int size() const { return static_cast<int>(cells.size()); }
+
+    bool contains(int cell) const { return (inFrontierBits[cell >> 6] >> (cell & 63)) & 1; }
+
+    // The cell must not be in the frontier already.
+    void add(int cell) {
+        inFrontierBits[cell >> 6] |= uint64_t(1) << (cell & 63);
+        cells.push_back(cell);
+    }
+
+    int removeAt(int index) {
+        int cell = cells[index];
+        cells[index] = cells.back();
+        cells.pop_back();
+        inFrontierBits[cell >> 6] &= ~(uint64_t(1) << (cell & 63));
+        return cell;
+    }
+
+    size_t memoryBytes() const { return cells.capacity() * sizeof(int) + inFrontierBits.capacity() * sizeof(uint64_t); }
+};
+
+// Randomized Prim's algorithm: grows the maze from the entrance by carving a random
+// frontier cell into a random already-carved neighbor. One cell per step(), which looks at
+// the cell's neighbours once: the carved ones to join and the untouched ones to queue.
+class PrimGenerator : public MazeGenerator {
+private:
+    Frontier frontier;
+
+protected:
+    void start() override;
+
+public:
+    explicit PrimGenerator(Graph& graph) : MazeGenerator(graph) {}
+
+    Algorithm getAlgorithm() const override { return Algorithm::Prim; }
+    bool isDone() const override { return frontier.empty(); }
+    bool step() override;
+    size_t workingMemoryBytes() const override { return frontier.memoryBytes(); }
+};
@@ -0,0 +1,114 @@
+#include "Profiler.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <fstream>
+#include <utility>
+
+using namespace std;
+
+Profiler::Profiler(vector<string> phaseNames, string threadName)
+    : names(move(phaseNames)), threadName(move(threadName)), sessionStart(Clock::now()) {
+    history.assign((names.size() + 1) * HISTORY, 0.0f);
+    current.assign(names.size(), Clock::duration::zero());
+    latencies.assign(HISTORY, 0.0f);
+    scratch.reserve(HISTORY);
+}
+
+void Profiler::beginFrame() {
+    frameStart = Clock::now();
+    fill(current.begin(), current.end(), Clock::duration::zero());
+    drawCalls = vertices = 0;
+}
+
+void Profiler::endFrame() {
+    Clock::time_point end = Clock::now();
+    for (size_t phase = 0; phase < names.size(); ++phase) {
+        history[phase * HISTORY + frameSlot] = chrono::duration<float, milli>(current[phase]).count();
+    }
+    history[names.size() * HISTORY + frameSlot] = chrono::duration<float, milli>(end - frameStart).count();
+    frameSlot = (frameSlot + 1) % HISTORY;
+    framesRecorded = min(framesRecorded + 1, HISTORY);
+    lastDrawCalls = drawCalls;
+    lastVertices = vertices;
+
+    if (trace.size() < traceLimit) {
+        trace.push_back({ phaseCount(), frameStart, end - frameStart });
+    }
+}
+
+void Profiler::addSample(int phase, Clock::time_point start, Clock::time_point end) {
+    current[phase] += end - start;
+    if (trace.size() < traceLimit) {
+        trace.push_back({ phase, start, end - start });
+    }
+}
+
+void Profiler::addInputLatency(Clock::duration latency) {
+    latencies[latencySlot] = chrono::duration<float, milli>(latency).count();
+    latencySlot = (latencySlot + 1) % HISTORY;
+    latenciesRecorded = min(latenciesRecorded + 1, HISTORY);
+}
+
+Profiler::PhaseStats Profiler::stats(int phase) const {
+    return summarize(&history[phase * HISTORY], framesRecorded);
+}
+
+Profiler::PhaseStats Profiler::summarize(const float* samples, int count) const {
+    PhaseStats result;
+    if (count == 0) {
+        return result;
+    }
+
+    scratch.assign(samples, samples + count);
+    double sum = 0;
+    for (float sample : scratch) {
+        sum += sample;
+    }
+    result.avgMs = sum / count;
+    result.minMs = *min_element(scratch.begin(), scratch.end());
+
+    // With 120 samples the 99th percentile is the second-worst one.
+    size_t rank = min(scratch.size() - 1, static_cast<size_t>(scratch.size() * 0.99));
+    nth_element(scratch.begin(), scratch.begin() + rank, scratch.end());
+    result.p99Ms = scratch[rank];
+    return result;
+}
+
+void Profiler::startTrace(size_t maxEvents) {
+    trace.clear();
+    trace.reserve(maxEvents);
+    traceLimit = maxEvents;
+}
+
+bool Profiler::writeTrace(const string& path, const vector<const Profiler*>& threads) {
+    ofstream out(path);
+    if (!out) {
+        return false;
+    }
+    Clock::time_point start = Clock::time_point::max();
+    for (const Profiler* profiler : threads) {
+        start = min(start, profiler->sessionStart);
+    }
+
+    // Chrome trace-event format: complete ("X") events with microsecond timestamps. Each
+    // profiler is a named track; frames and phases share it, so a frame's phases nest under it.
+    out << "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[";
+    char line[256];
+    for (size_t tid = 1; tid <= threads.size(); ++tid) {
+        const Profiler& profiler = *threads[tid - 1];
+        snprintf(line, sizeof(line), "%s\n{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%zu,\"args\":{\"name\":\"%s\"}}",
+            tid > 1 ? "," : "", tid, profiler.threadName.c_str());
+        out << line;
+        for (const TraceEvent& event : profiler.trace) {
+            const char* name = event.phase < profiler.phaseCount() ? profiler.names[event.phase].c_str() : "frame";
+            snprintf(line, sizeof(line), ",\n{\"name\":\"%s\",\"ph\":\"X\",\"pid\":1,\"tid\":%zu,\"ts\":%.3f,\"dur\":%.3f}",
+                name, tid,
+                chrono::duration<double, micro>(event.start - start).count(),
+                chrono::duration<double, micro>(event.duration).count());
+            out << line;
+        }
+    }
+    out << "\n]}\n";
+    return static_cast<bool>(out);
+}
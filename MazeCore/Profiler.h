@@ -0,0 +1,101 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Per-phase frame timings. The game wraps each phase of a frame in a ScopedPhase, and the
+// profiler keeps the last HISTORY frames so it can report rolling min/avg/p99 per phase.
+// Optionally every phase is also recorded for a Chrome trace (chrome://tracing, Perfetto).
+// Nothing here allocates once constructed, except writing the trace. A profiler belongs to one
+// thread; a program with several threads gives each its own and writes their traces together.
+class Profiler {
+public:
+    using Clock = std::chrono::steady_clock;
+    static const int HISTORY = 120;
+
+    struct PhaseStats {
+        double minMs = 0, avgMs = 0, p99Ms = 0;
+    };
+
+private:
+    struct TraceEvent {
+        int phase;
+        Clock::time_point start;
+        Clock::duration duration;
+    };
+
+    std::vector<std::string> names;
+    std::string threadName;
+    std::vector<float> history;       // (phases + 1) rows of HISTORY frame samples; the last row is the whole frame
+    std::vector<Clock::duration> current;
+    int frameSlot = 0;
+    int framesRecorded = 0;
+    Clock::time_point frameStart;
+    Clock::time_point sessionStart;
+    size_t drawCalls = 0, vertices = 0;
+    size_t lastDrawCalls = 0, lastVertices = 0;
+
+    std::vector<TraceEvent> trace;
+    size_t traceLimit = 0;
+    std::vector<float> latencies;     // the last HISTORY input latencies, a ring like the frame history
+    int latencySlot = 0;
+    int latenciesRecorded = 0;
+    mutable std::vector<float> scratch;
+
+    PhaseStats summarize(const float* samples, int count) const;
+
+public:
+    explicit Profiler(std::vector<std::string> phaseNames, std::string threadName = "main");
+
+    void beginFrame();
+    void endFrame();
+
+    // Adds time to a phase of the current frame. A phase may be entered more than once per frame.
+    void addSample(int phase, Clock::time_point start, Clock::time_point end);
+
+    void countDraws(size_t calls, size_t vertexCount) { drawCalls += calls; vertices += vertexCount; }
+    size_t getDrawCalls() const { return lastDrawCalls; }
+    size_t getVertices() const { return lastVertices; }
+
+    // Stats over the recorded history. phaseCount() itself stands for the whole frame.
+    int phaseCount() const { return static_cast<int>(names.size()); }
+    const std::string& phaseName(int phase) const { return names[phase]; }
+    PhaseStats stats(int phase) const;
+
+    // Time from an input being read to the frame showing its effect being presented.
+    void addInputLatency(Clock::duration latency);
+    PhaseStats inputLatency() const { return summarize(latencies.data(), latenciesRecorded); }
+
+    // Keeps up to maxEvents phase and frame events (reserved now) for writeTrace().
+    void startTrace(size_t maxEvents);
+    bool tracing() const { return traceLimit > 0; }
+    bool writeTrace(const std::string& path) const { return writeTrace(path, { this }); }
+
+    // One trace file with a track per profiler, on a common time axis.
+    static bool writeTrace(const std::string& path, const std::vector<const Profiler*>& threads);
+};
+
+// Times the enclosing scope as one phase. stop() ends it early when the phase is only part of a scope.
+class ScopedPhase {
+private:
+    Profiler& profiler;
+    int phase;
+    Profiler::Clock::time_point start;
+    bool running = true;
+
+public:
+    ScopedPhase(Profiler& profiler, int phase) : profiler(profiler), phase(phase), start(Profiler::Clock::now()) {}
+    ~ScopedPhase() { stop(); }
+    ScopedPhase(const ScopedPhase&) = delete;
+    ScopedPhase& operator=(const ScopedPhase&) = delete;
+
+    void stop() {
+        if (running) {
+            profiler.addSample(phase, start, Profiler::Clock::now());
+            running = false;
+        }
+    }
+};
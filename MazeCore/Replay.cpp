@@ -0,0 +1,129 @@
+#include "Replay.h"
+
+#include "ByteIO.h"
+#include "MazeFile.h"
+
+#include <cstring>
+
+using namespace std;
+
+namespace {
+    const char REPLAY_MAGIC[4] = { 'M', 'Q', 'R', 'P' };
+    const uint16_t REPLAY_VERSION = 1;
+    const size_t REPLAY_HEADER_SIZE = 56;
+    const uint16_t FLAG_MAZE_FILE = 1;
+    const int MOVE_BITS = 2;
+}
+
+void appendReplay(string& out, const Replay& replay) {
+    uint32_t timeLimitBits;
+    memcpy(&timeLimitBits, &replay.timeLimit, sizeof(timeLimitBits));
+
+    out.append(REPLAY_MAGIC, sizeof(REPLAY_MAGIC));
+    putLittleEndian(out, REPLAY_VERSION, 2);
+    putLittleEndian(out, replay.mazeFile.empty() ? 0 : FLAG_MAZE_FILE, 2);
+    putLittleEndian(out, static_cast<uint32_t>(replay.width), 4);
+    putLittleEndian(out, static_cast<uint32_t>(replay.height), 4);
+    putLittleEndian(out, replay.seed, 8);
+    putLittleEndian(out, static_cast<uint8_t>(replay.algorithm), 1);
+    putLittleEndian(out, static_cast<uint8_t>(replay.difficulty), 1);
+    putLittleEndian(out, static_cast<uint8_t>(replay.outcome), 1);
+    putLittleEndian(out, 0, 1);
+    putLittleEndian(out, GameSession::TICK_RATE, 2);
+    putLittleEndian(out, 0, 2);
+    putLittleEndian(out, timeLimitBits, 4);
+    putLittleEndian(out, static_cast<uint32_t>(replay.undos), 4);
+    putLittleEndian(out, static_cast<uint64_t>(replay.ticksPlayed), 8);
+    putLittleEndian(out, static_cast<uint32_t>(replay.events.size()), 4);
+    putLittleEndian(out, 0, 4);
+
+    // Moves come a few ticks apart, so the delta and the key usually share a single byte.
+    int64_t previous = 0;
+    for (const ReplayEvent& event : replay.events) {
+        putVarint(out, static_cast<uint64_t>(event.tick - previous) << MOVE_BITS | static_cast<uint64_t>(event.move));
+        previous = event.tick;
+    }
+    out += replay.mazeFile;
+}
+
+bool readReplay(const uint8_t* data, size_t size, Replay& replay) {
+    if (size < REPLAY_HEADER_SIZE || memcmp(data, REPLAY_MAGIC, sizeof(REPLAY_MAGIC)) != 0
+        || getLittleEndian(data + 4, 2) != REPLAY_VERSION || getLittleEndian(data + 28, 2) != GameSession::TICK_RATE) {
+        return false;
+    }
+    uint64_t algorithm = data[24];
+    uint64_t outcome = data[26];
+    if (algorithm >= ALGORITHM_COUNT || outcome > static_cast<uint64_t>(SessionState::OutOfTime)) {
+        return false;
+    }
+
+    uint32_t timeLimitBits = static_cast<uint32_t>(getLittleEndian(data + 32, 4));
+    replay.width = static_cast<int>(getLittleEndian(data + 8, 4));
+    replay.height = static_cast<int>(getLittleEndian(data + 12, 4));
+    replay.seed = getLittleEndian(data + 16, 8);
+    replay.algorithm = static_cast<Algorithm>(algorithm);
+    replay.difficulty = data[25];
+    replay.outcome = static_cast<SessionState>(outcome);
+    memcpy(&replay.timeLimit, &timeLimitBits, sizeof(timeLimitBits));
+    replay.undos = static_cast<int>(getLittleEndian(data + 36, 4));
+    replay.ticksPlayed = static_cast<int64_t>(getLittleEndian(data + 40, 8));
+    if (replay.width <= 0 || replay.height <= 0 || replay.ticksPlayed < 0) {
+        return false;
+    }
+
+    uint64_t count = getLittleEndian(data + 48, 4);
+    const uint8_t* cursor = data + REPLAY_HEADER_SIZE;
+    const uint8_t* end = data + size;
+    replay.events.clear();
+    replay.events.reserve(static_cast<size_t>(min<uint64_t>(count, size)));
+    int64_t tick = 0;
+    for (uint64_t i = 0; i < count; ++i) {
+        uint64_t value;
+        if (!getVarint(cursor, end, value)) {
+            return false;
+        }
+        tick += static_cast<int64_t>(value >> MOVE_BITS);
+        replay.events.push_back({ tick, static_cast<Move>(value & 3) });
+    }
+
+    replay.mazeFile.clear();
+    if (getLittleEndian(data + 6, 2) & FLAG_MAZE_FILE) {
+        replay.mazeFile.assign(reinterpret_cast<const char*>(cursor), end - cursor);
+    }
+    return true;
+}
+
+bool buildReplayMaze(const Replay& replay, Graph& graph, unique_ptr<MazeGenerator>& generator) {
+    if (graph.getColumns() != replay.width || graph.getRows() != replay.height) {
+        return false;
+    }
+    if (!replay.mazeFile.empty()) {
+        return loadMaze(reinterpret_cast<const uint8_t*>(replay.mazeFile.data()), replay.mazeFile.size(), graph);
+    }
+
+    if (!generator || &generator->getGraph() != &graph || generator->getAlgorithm() != replay.algorithm) {
+        generator = makeGenerator(replay.algorithm, graph, replay.seed);
+    }
+    else {
+        generator->reset(replay.seed);
+    }
+    while (generator->step()) {
+    }
+    return true;
+}
+
+bool simulateReplay(const Replay& replay, GameSession& session) {
+    session.start(replay.timeLimit, replay.undos);
+
+    // Each tick of the game applies that tick's moves, then advances the clock; likewise here.
+    for (const ReplayEvent& event : replay.events) {
+        while (session.getTicksPlayed() < event.tick && session.getState() == SessionState::Playing) {
+            session.tick();
+        }
+        session.move(event.move);
+    }
+    while (session.getTicksPlayed() < replay.ticksPlayed && session.getState() == SessionState::Playing) {
+        session.tick();
+    }
+    return session.getState() == replay.outcome && session.getTicksPlayed() == replay.ticksPlayed;
+}
@@ -0,0 +1,61 @@
+#pragma once
+
+#include "GameSession.h"
+#include "Graph.h"
+#include "MazeGenerator.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+// One recorded move attempt: the tick it was made on (GameSession::getTicksPlayed() at the
+// time) and the key. Attempts into a wall are kept too, so a replay is the player's input.
+struct ReplayEvent {
+    int64_t tick;
+    Move move;
+};
+
+// Everything needed to play a round again exactly: where the maze came from, the round's
+// limits as they were calibrated (so a replay does not depend on the calibration code), the
+// moves, and the recorded result to check a re-simulation against.
+//
+// Replay file ("MQRP"), little-endian:
+//
+//    0  "MQRP"              4  version (u16)         6  flags (u16), bit 0: maze file included
+//    8  width (u32)        12  height (u32)         16  seed (u64)
+//   24  algorithm (u8)     25  difficulty (u8)      26  outcome (u8)    27  reserved
+//   28  tick rate (u16)    30  reserved (u16)       32  time limit (f32 seconds)   36  undos (u32)
+//   40  ticks played (u64)                          48  event count (u32)          52  reserved
+//   56  events, each one varint: ticks since the previous event << 2 | move
+//
+// then, when flag bit 0 is set, the maze as a maze file (MazeFile.h), for mazes that cannot
+// be regenerated from their seed. A round of a few hundred moves takes well under a kilobyte.
+struct Replay {
+    int width = 0, height = 0;
+    uint64_t seed = 0;
+    Algorithm algorithm = Algorithm::Prim;
+    int difficulty = 0;
+    float timeLimit = 0;  // as given to GameSession::start()
+    int undos = 0;
+    SessionState outcome = SessionState::Playing;  // Playing if the round was abandoned
+    int64_t ticksPlayed = 0;
+    std::vector<ReplayEvent> events;
+    std::string mazeFile;  // empty when the maze is regenerated from algorithm and seed
+};
+
+void appendReplay(std::string& out, const Replay& replay);
+
+// Returns false for anything but a whole replay of a known version and this build's tick rate.
+bool readReplay(const uint8_t* data, size_t size, Replay& replay);
+
+// Puts the replay's maze into graph, which must have the replay's size: loaded from the
+// included maze file, or regenerated from the seed. generator is kept between calls and only
+// replaced when it is not already running the replay's algorithm on graph.
+bool buildReplayMaze(const Replay& replay, Graph& graph, std::unique_ptr<MazeGenerator>& generator);
+
+// Plays the recorded moves into session (on the replay's maze) on their ticks and runs it to
+// the recorded tick count, as fast as the CPU allows. Returns whether the outcome and tick
+// count match the recording.
+bool simulateReplay(const Replay& replay, GameSession& session);
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <cstdint>
+
+// splitmix64: turns consecutive or low-entropy seeds into well-mixed 64-bit values.
+constexpr uint64_t splitmix64(uint64_t& state) {
+    uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+    z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+    z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+    return z ^ (z >> 31);
+}
+
+// xoshiro256** (Blackman and Vigna). Much faster than rand(), good in the low bits too, and
+// small enough that every generator owns its own instance instead of sharing global state.
+// Everything is constexpr, so mazes baked at compile time (BakedMaze.h) draw the same numbers.
+class Rng {
+private:
+    uint64_t state[4] = {};
+
+    static constexpr uint64_t rotl(uint64_t x, int k) { return (x << k) | (x >> (64 - k)); }
+
+public:
+    explicit constexpr Rng(uint64_t seed = 0) { this->seed(seed); }
+
+    // Any 64-bit value, 0 included, expands to a valid non-zero state.
+    constexpr void seed(uint64_t seed) {
+        for (uint64_t& word : state) {
+            word = splitmix64(seed);
+        }
+    }
+
+    constexpr uint64_t next() {
+        uint64_t result = rotl(state[1] * 5, 7) * 9;
+        uint64_t t = state[1] << 17;
+        state[2] ^= state[0];
+        state[3] ^= state[1];
+        state[1] ^= state[2];
+        state[0] ^= state[3];
+        state[2] ^= t;
+        state[3] = rotl(state[3], 45);
+        return result;
+    }
+
+    // Uniform value in [0, bound) with no modulo bias, using Lemire's multiply-and-reject.
+    // The rejection threshold (one division) is only computed in the rare retry case.
+    constexpr uint32_t bounded(uint32_t bound) {
+        uint64_t product = (next() >> 32) * bound;
+        uint32_t low = static_cast<uint32_t>(product);
+        if (low < bound) {
+            uint32_t threshold = (0u - bound) % bound;
+            while (low < threshold) {
+                product = (next() >> 32) * bound;
+                low = static_cast<uint32_t>(product);
+            }
+        }
+        return static_cast<uint32_t>(product >> 32);
+    }
+};
+
+// Seed of the index-th maze in a batch started from baseSeed. Lets any maze of a batch be
+// regenerated on its own, whichever worker happened to build it.
+constexpr uint64_t deriveSeed(uint64_t baseSeed, uint64_t index) {
+    uint64_t state = baseSeed ^ (index * 0xD1B54A32D192ED03ull);
+    return splitmix64(state);
+}
@@ -0,0 +1,24 @@
+#include "SavedMazeGenerator.h"
+
+#include <utility>
+
+using namespace std;
+
+SavedMazeGenerator::SavedMazeGenerator(Graph& graph, Algorithm algorithm, vector<uint32_t> edges)
+    : MazeGenerator(graph), algorithm(algorithm), edges(move(edges)) {
+}
+
+void SavedMazeGenerator::start() {
+    carved = 0;
+    currentNode = graph.getNode(0, 0);
+}
+
+bool SavedMazeGenerator::step() {
+    if (isDone()) {
+        return false;
+    }
+    uint32_t edge = edges[carved++];
+    graph.carveEdge(edge);
+    currentNode = static_cast<int>(edge / 2);
+    return true;
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include "MazeGenerator.h"
+
+#include <cstdint>
+#include <vector>
+
+// Plays a saved maze (see MazeFile.h) back through the generator interface, opening one of its
+// passages per step in file order, so the game can build and play it like a generated one.
+// getAlgorithm() and the seed are whatever the file recorded; every reset carves the same maze.
+class SavedMazeGenerator : public MazeGenerator {
+private:
+    Algorithm algorithm;
+    std::vector<uint32_t> edges;  // carve log edge ids of the saved maze's open walls
+    size_t carved = 0;
+
+protected:
+    void start() override;
+
+public:
+    SavedMazeGenerator(Graph& graph, Algorithm algorithm, std::vector<uint32_t> edges);
+
+    Algorithm getAlgorithm() const override { return algorithm; }
+    bool isDone() const override { return carved >= edges.size(); }
+    bool step() override;
+    size_t workingMemoryBytes() const override { return edges.capacity() * sizeof(uint32_t); }
+};
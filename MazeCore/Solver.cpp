@@ -0,0 +1,147 @@
+#include "Solver.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <functional>
+
+using namespace std;
+
+Solver::Solver(const Graph& graph) : graph(graph) {
+}
+
+int Solver::openNeighbors(int cell, int out[4]) const {
+    int columns = graph.getColumns();
+    uint8_t walls = graph.getWalls(cell);
+    int count = 0;
+    if (!(walls & WALL_LEFT)) out[count++] = cell - 1;
+    if (!(walls & WALL_RIGHT)) out[count++] = cell + 1;
+    if (!(walls & WALL_TOP)) out[count++] = cell - columns;
+    if (!(walls & WALL_BOTTOM)) out[count++] = cell + columns;
+    return count;
+}
+
+void Solver::startDistances(int source) {
+    distances.assign(graph.cellCount(), UNREACHABLE);
+    queue.resize(graph.cellCount());
+
+    // Every cell is queued at most once, so the queue is a plain array with a read and a write index.
+    queueHead = queueTail = 0;
+    distances[source] = 0;
+    queue[queueTail++] = source;
+}
+
+bool Solver::advanceDistances(int maxCells) {
+    int neighbors[4];
+    for (int processed = 0; queueHead < queueTail && (maxCells <= 0 || processed < maxCells); ++processed) {
+        int cell = queue[queueHead++];
+        uint32_t next = distances[cell] + 1;
+        int count = openNeighbors(cell, neighbors);
+        for (int i = 0; i < count; ++i) {
+            if (distances[neighbors[i]] == UNREACHABLE) {
+                distances[neighbors[i]] = next;
+                queue[queueTail++] = neighbors[i];
+            }
+        }
+    }
+    return queueHead == queueTail;
+}
+
+bool Solver::pathToSource(int cell, vector<int>& path) const {
+    path.clear();
+    if (distances[cell] == UNREACHABLE) {
+        return false;
+    }
+
+    int neighbors[4];
+    path.push_back(cell);
+    while (distances[cell] > 0) {
+        int count = openNeighbors(cell, neighbors);
+        for (int i = 0; i < count; ++i) {
+            if (distances[neighbors[i]] == distances[cell] - 1) {
+                cell = neighbors[i];
+                break;
+            }
+        }
+        path.push_back(cell);
+    }
+    return true;
+}
+
+uint32_t Solver::estimate(int cell) const {
+    return static_cast<uint32_t>(abs(graph.cellX(cell) - goalX) + abs(graph.cellY(cell) - goalY));
+}
+
+void Solver::startPath(int from, int to) {
+    if (stamp.size() != static_cast<size_t>(graph.cellCount())) {
+        stamp.assign(graph.cellCount(), 0);
+        cost.resize(graph.cellCount());
+        cameFrom.resize(graph.cellCount());
+        query = 0;
+    }
+    if (++query == 0) {
+        fill(stamp.begin(), stamp.end(), 0);
+        query = 1;
+    }
+    goal = to;
+    goalX = graph.cellX(to);
+    goalY = graph.cellY(to);
+    goalReached = false;
+
+    // Open entries pack (estimated total << 32 | cell) so the heap orders on the estimate alone.
+    // Stale entries are skipped when popped instead of being removed from the heap.
+    open.clear();
+    stamp[from] = query;
+    cost[from] = 0;
+    cameFrom[from] = -1;
+    open.push_back(static_cast<uint64_t>(estimate(from)) << 32 | static_cast<uint32_t>(from));
+}
+
+bool Solver::advancePath(int maxCells) {
+    int neighbors[4];
+    for (int processed = 0; !goalReached && !open.empty() && (maxCells <= 0 || processed < maxCells); ++processed) {
+        pop_heap(open.begin(), open.end(), greater<uint64_t>());
+        uint64_t entry = open.back();
+        open.pop_back();
+        int cell = static_cast<int>(entry & 0xFFFFFFFFu);
+        if ((entry >> 32) != cost[cell] + estimate(cell)) {
+            continue;
+        }
+        if (cell == goal) {
+            goalReached = true;
+            break;
+        }
+
+        uint32_t next = cost[cell] + 1;
+        int count = openNeighbors(cell, neighbors);
+        for (int i = 0; i < count; ++i) {
+            int neighbor = neighbors[i];
+            if (stamp[neighbor] == query && cost[neighbor] <= next) {
+                continue;
+            }
+            stamp[neighbor] = query;
+            cost[neighbor] = next;
+            cameFrom[neighbor] = cell;
+            open.push_back(static_cast<uint64_t>(next + estimate(neighbor)) << 32 | static_cast<uint32_t>(neighbor));
+            push_heap(open.begin(), open.end(), greater<uint64_t>());
+        }
+    }
+    return goalReached || open.empty();
+}
+
+bool Solver::takePath(vector<int>& path) const {
+    path.clear();
+    if (!goalReached) {
+        return false;
+    }
+    for (int at = goal; at != -1; at = cameFrom[at]) {
+        path.push_back(at);
+    }
+    reverse(path.begin(), path.end());
+    return true;
+}
+
+size_t Solver::memoryBytes() const {
+    return distances.capacity() * sizeof(uint32_t) + queue.capacity() * sizeof(int)
+        + stamp.capacity() * sizeof(uint32_t) + cost.capacity() * sizeof(uint32_t)
+        + cameFrom.capacity() * sizeof(int) + open.capacity() * sizeof(uint64_t);
+}
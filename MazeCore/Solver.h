@@ -0,0 +1,63 @@
+#pragma once
+
+#include "Graph.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Path queries over a finished Graph, moving only through carved walls.
+// All scratch buffers are kept between calls, so after the first query on a maze size
+// solving does not allocate.
+class Solver {
+private:
+    const Graph& graph;
+    std::vector<uint32_t> distances;
+    std::vector<int> queue;
+    size_t queueHead = 0, queueTail = 0;
+
+    // A* state is only valid where stamp matches the current query, so a new query does not
+    // have to clear arrays the size of the maze.
+    std::vector<uint32_t> stamp;
+    std::vector<uint32_t> cost;
+    std::vector<int> cameFrom;
+    std::vector<uint64_t> open;
+    uint32_t query = 0;
+    int goal = -1, goalX = 0, goalY = 0;
+    bool goalReached = false;
+
+    // Writes the cells reachable in one move from cell and returns how many there are.
+    int openNeighbors(int cell, int out[4]) const;
+
+    // Manhattan distance from cell to the goal of the current A* query.
+    uint32_t estimate(int cell) const;
+
+public:
+    static constexpr uint32_t UNREACHABLE = UINT32_MAX;
+
+    explicit Solver(const Graph& graph);
+
+    // Breadth-first distances (in moves) from source to every cell. The search can be run a
+    // slice at a time like generation: startDistances() and then advanceDistances() until it
+    // returns true. A limit of 0 means "no limit".
+    void startDistances(int source);
+    bool advanceDistances(int maxCells);
+    void computeDistances(int source) { startDistances(source); advanceDistances(0); }
+    bool distancesReady() const { return !distances.empty() && queueHead == queueTail; }
+    uint32_t distanceTo(int cell) const { return distances[cell]; }
+
+    // Follows the distance field downhill from cell back to its source. The path includes both
+    // ends; returns false, leaving path empty, if cell was not reached.
+    bool pathToSource(int cell, std::vector<int>& path) const;
+
+    // Shortest path from one cell to another with A* (Manhattan heuristic), sliced the same way:
+    // startPath() and then advancePath() until it returns true, a limit of 0 again meaning "no
+    // limit". takePath() then gives the path, both ends included; it returns false, leaving
+    // path empty, if the goal cannot be reached.
+    void startPath(int from, int to);
+    bool advancePath(int maxCells);
+    bool takePath(std::vector<int>& path) const;
+    bool findPath(int from, int to, std::vector<int>& path) { startPath(from, to); advancePath(0); return takePath(path); }
+
+    size_t memoryBytes() const;
+};
@@ -0,0 +1,109 @@
+#include "TiledGenerator.h"
+
+#include "Rng.h"
+#include "UnionFind.h"
+
+#include <algorithm>
+#include <atomic>
+#include <memory>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+namespace {
+    // Two neighbouring tiles, and the side of first that faces second.
+    struct TileSeam {
+        int first, second;
+        bool vertical;  // second is to the right of first (else below it)
+    };
+
+    // A worker's maze for one tile size. Edge tiles are smaller, so a worker keeps one per size.
+    struct TileMaze {
+        Graph graph;
+        unique_ptr<MazeGenerator> generator;
+
+        TileMaze(int columns, int rows, Algorithm algorithm) : graph(columns, rows), generator(makeGenerator(algorithm, graph, 0)) {}
+    };
+}
+
+size_t generateTiled(Graph& graph, Algorithm algorithm, uint64_t seed, int threads, int tileSize) {
+    graph.reset();
+    int columns = graph.getColumns(), rows = graph.getRows();
+    int tilesX = (columns + tileSize - 1) / tileSize;
+    int tilesY = (rows + tileSize - 1) / tileSize;
+    int tileCount = tilesX * tilesY;
+
+    int threadCount = threads > 0 ? threads : static_cast<int>(thread::hardware_concurrency());
+    threadCount = max(1, min(threadCount, tileCount));
+
+    // Workers pull tile indices from a shared counter. Tiles do not overlap, so each copies its
+    // maze into the graph without any locking.
+    atomic<int> nextTile{ 0 };
+    atomic<size_t> workerMemory{ 0 };
+    auto worker = [&]() {
+        vector<unique_ptr<TileMaze>> mazes;
+        for (int tile = nextTile++; tile < tileCount; tile = nextTile++) {
+            int left = tile % tilesX * tileSize, top = tile / tilesX * tileSize;
+            int width = min(tileSize, columns - left), height = min(tileSize, rows - top);
+
+            auto found = find_if(mazes.begin(), mazes.end(), [&](const unique_ptr<TileMaze>& maze) {
+                return maze->graph.getColumns() == width && maze->graph.getRows() == height;
+            });
+            if (found == mazes.end()) {
+                mazes.emplace_back(new TileMaze(width, height, algorithm));
+                found = mazes.end() - 1;
+            }
+            MazeGenerator& generator = *(*found)->generator;
+            generator.reset(deriveSeed(seed, tile));
+            while (generator.step()) {
+            }
+            graph.copyTile((*found)->graph, left, top);
+        }
+        for (const unique_ptr<TileMaze>& maze : mazes) {
+            workerMemory += maze->graph.memoryBytes() + maze->generator->workingMemoryBytes();
+        }
+    };
+
+    vector<thread> workers;
+    for (int i = 1; i < threadCount; ++i) {
+        workers.emplace_back(worker);
+    }
+    worker();
+    for (thread& t : workers) {
+        t.join();
+    }
+
+    // Kruskal's algorithm over the tiles: seams in random order, a door wherever a seam joins
+    // two tiles that are not connected yet. tileCount - 1 doors, one spanning tree.
+    vector<TileSeam> seams;
+    seams.reserve(static_cast<size_t>(tileCount) * 2);
+    for (int tile = 0; tile < tileCount; ++tile) {
+        if (tile % tilesX + 1 < tilesX) seams.push_back({ tile, tile + 1, true });
+        if (tile / tilesX + 1 < tilesY) seams.push_back({ tile, tile + tilesX, false });
+    }
+    Rng rng(deriveSeed(seed, tileCount));
+    for (size_t i = seams.size(); i > 1; --i) {
+        swap(seams[i - 1], seams[rng.bounded(static_cast<uint32_t>(i))]);
+    }
+
+    UnionFind tiles;
+    tiles.reset(tileCount);
+    for (const TileSeam& seam : seams) {
+        if (!tiles.unite(seam.first, seam.second)) {
+            continue;
+        }
+        int left = seam.first % tilesX * tileSize, top = seam.first / tilesX * tileSize;
+        if (seam.vertical) {
+            int y = top + static_cast<int>(rng.bounded(min(tileSize, rows - top)));
+            int cell = graph.getNode(left + tileSize - 1, y);
+            graph.removeWalls(cell, cell + 1);
+        }
+        else {
+            int x = left + static_cast<int>(rng.bounded(min(tileSize, columns - left)));
+            int cell = graph.getNode(x, top + tileSize - 1);
+            graph.removeWalls(cell, cell + columns);
+        }
+    }
+    return workerMemory + seams.capacity() * sizeof(TileSeam) + tiles.memoryBytes();
+}
@@ -0,0 +1,25 @@
+#pragma once
+
+#include "Graph.h"
+#include "MazeGenerator.h"
+
+#include <cstddef>
+#include <cstdint>
+
+const int DEFAULT_TILE_SIZE = 256;
+
+// Builds a maze on several cores at once. The grid is cut into tileSize x tileSize tiles
+// (smaller along the right and bottom edges), each generated as a perfect maze of its own by
+// algorithm on a worker thread and copied in. The tiles are then stitched together: a
+// union-find over the tiles picks a random spanning tree of tile neighbours, and each pair
+// it joins gets one door through their shared wall, so the whole grid is one perfect maze.
+//
+// Tile i is built from deriveSeed(seed, i) and the stitching from its own derived seed, so a
+// seed gives the same maze with any thread count. Seams between tiles are straight walls with
+// a single door, which shows on small mazes; this is meant for very large ones.
+//
+// graph is reset first. Tiles bypass the carve log (only the doors go through removeWalls()),
+// so it is meant for graphs without carve logging. threads <= 0 uses every core. Returns the
+// bytes it worked in on top of graph: every worker's tile mazes and their generators, plus the
+// stitching's seams and union-find.
+size_t generateTiled(Graph& graph, Algorithm algorithm, uint64_t seed, int threads, int tileSize = DEFAULT_TILE_SIZE);
@@ -0,0 +1,41 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Hands the latest value from one writer thread to one reader thread without either waiting.
+// There are three slots: the writer fills its back slot and swaps it with the middle one, and
+// the reader swaps the middle slot for its front slot only when something new has been
+// published. The writer never blocks on a slow reader; the reader just skips the values it
+// was too slow to see and always gets the newest whole one.
+template <typename T>
+class TripleBuffer {
+private:
+    static const uint8_t INDEX = 3;
+    static const uint8_t FRESH = 4;  // set in middle while it holds a value the reader has not taken
+
+    T slots[3];
+    std::atomic<uint8_t> middle{ 1 };
+    uint8_t backIndex = 0;   // writer only
+    uint8_t frontIndex = 2;  // reader only
+
+public:
+    // Writer side: fill back() completely (it holds an old value), then publish() it.
+    T& back() { return slots[backIndex]; }
+
+    void publish() {
+        backIndex = middle.exchange(static_cast<uint8_t>(backIndex | FRESH), std::memory_order_acq_rel) & INDEX;
+    }
+
+    // Reader side: fetch() takes the newest published value, if there is one, and returns
+    // whether front() changed. front() stays valid until the next fetch().
+    bool fetch() {
+        if (!(middle.load(std::memory_order_relaxed) & FRESH)) {
+            return false;
+        }
+        frontIndex = middle.exchange(frontIndex, std::memory_order_acq_rel) & INDEX;
+        return true;
+    }
+
+    const T& front() const { return slots[frontIndex]; }
+};
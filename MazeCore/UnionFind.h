@@ -0,0 +1,48 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+// Disjoint sets over 0..n-1 with path halving and union by size, so find() is effectively
+// constant time. Used by Kruskal's generator and by anything that stitches regions together.
+class UnionFind {
+private:
+    std::vector<int> parent;
+    std::vector<int> setSize;
+
+public:
+    void reset(int count) {
+        parent.resize(count);
+        setSize.assign(count, 1);
+        for (int i = 0; i < count; ++i) {
+            parent[i] = i;
+        }
+    }
+
+    int find(int element) {
+        while (parent[element] != element) {
+            parent[element] = parent[parent[element]];
+            element = parent[element];
+        }
+        return element;
+    }
+
+    // Merges the sets holding a and b. Returns false if they were already the same set.
+    bool unite(int a, int b) {
+        a = find(a);
+        b = find(b);
+        if (a == b) {
+            return false;
+        }
+        if (setSize[a] < setSize[b]) {
+            std::swap(a, b);
+        }
+        parent[b] = a;
+        setSize[a] += setSize[b];
+        return true;
+    }
+
+    size_t memoryBytes() const { return (parent.capacity() + setSize.capacity()) * sizeof(int); }
+};
@@ -0,0 +1,173 @@
+#include "WallPlanes.h"
+
+#include "ByteIO.h"
+
+#include <algorithm>
+#include <bitset>
+
+using namespace std;
+
+namespace {
+    // Spreads reached bits towards higher bits (rightwards) through open right walls. Adding
+    // the reached cells that can go right to the open walls carries through each run of open
+    // walls, and the carries are exactly the cells the fill enters.
+    uint64_t fillRight(uint64_t reached, uint64_t right) {
+        uint64_t leaving = reached & right;
+        return reached | ((right + leaving) ^ right ^ leaving);
+    }
+
+    // The same towards lower bits (leftwards), through cells whose bit in enter says they can
+    // be entered from the next higher bit. Carries only run upwards, so this one is a parallel
+    // prefix: six steps for 64 cells.
+    uint64_t fillLeft(uint64_t reached, uint64_t enter) {
+        reached |= enter & (reached >> 1); enter &= enter >> 1;
+        reached |= enter & (reached >> 2); enter &= enter >> 2;
+        reached |= enter & (reached >> 4); enter &= enter >> 4;
+        reached |= enter & (reached >> 8); enter &= enter >> 8;
+        reached |= enter & (reached >> 16); enter &= enter >> 16;
+        return reached | (enter & (reached >> 32));
+    }
+
+    uint64_t countBits(uint64_t word) {
+        return bitset<64>(word).count();
+    }
+
+    // Bit i of the result is bit 0 of byte i of bytes (byte 0 the lowest): the multiply adds
+    // a shifted copy per byte and the eight bits meet in the top byte.
+    uint64_t gatherLowBits(uint64_t bytes) {
+        return ((bytes & 0x0101010101010101ull) * 0x0102040810204080ull) >> 56;
+    }
+}
+
+void WallPlanes::reset(int newColumns, int newRows) {
+    columns = newColumns;
+    rows = newRows;
+    rowWords = (static_cast<size_t>(columns) + 63) / 64;
+    origin = rowWords + 1;
+    size_t count = rowWords * (rows + 2) + 2;
+    words.assign(count, Word{ 0, 0 });
+    reached.assign(count, 0);
+    queued.assign(count, 0);
+    pending.resize(count);
+}
+
+void WallPlanes::build(const Graph& graph) {
+    reset(graph.getColumns(), graph.getRows());
+    const uint8_t* walls = graph.wallBytes();
+    for (int y = 0; y < rows; ++y) {
+        const uint8_t* row = walls + static_cast<size_t>(y) * columns;
+        Word* rowStart = words.data() + wordIndex(y, 0);
+
+        // Eight cells at a time from the wall bytes, then any left over one by one
+        int x = 0;
+        for (; x + 8 <= columns; x += 8) {
+            uint64_t bytes = getLittleEndian(row + x, 8);
+            rowStart[x / 64].right |= (~gatherLowBits(bytes >> 1) & 0xFF) << (x % 64);
+            rowStart[x / 64].down |= (~gatherLowBits(bytes >> 2) & 0xFF) << (x % 64);
+        }
+        for (; x < columns; ++x) {
+            rowStart[x / 64].right |= static_cast<uint64_t>(!(row[x] & WALL_RIGHT)) << (x % 64);
+            rowStart[x / 64].down |= static_cast<uint64_t>(!(row[x] & WALL_BOTTOM)) << (x % 64);
+        }
+
+        // Nothing leads out through the border
+        rowStart[(columns - 1) / 64].right &= ~(uint64_t(1) << ((columns - 1) % 64));
+        if (y == rows - 1) {
+            for (size_t word = 0; word < rowWords; ++word) {
+                rowStart[word].down = 0;
+            }
+        }
+    }
+}
+
+uint64_t WallPlanes::openEdges() const {
+    uint64_t count = 0;
+    for (const Word& word : words) {
+        count += countBits(word.right) + countBits(word.down);
+    }
+    return count;
+}
+
+uint64_t WallPlanes::floodFill(int cell) {
+    fill(reached.begin(), reached.end(), 0);
+    fill(queued.begin(), queued.end(), 0);
+    // Raw pointers, so the byte writes to waiting cannot be taken to move the vectors' storage
+    const Word* planes = words.data();
+    uint64_t* filledBits = reached.data();
+    uint8_t* waiting = queued.data();
+    uint32_t* stack = pending.data();
+    size_t top = 0;
+
+    // Adds bits to a word's reached cells and queues the word if any of them are new. Most
+    // calls add nothing, so the index is always written past the top and only kept if it
+    // counts, instead of branching on it.
+    auto reach = [&](size_t index, uint64_t bits) {
+        uint64_t added = bits & ~filledBits[index];
+        filledBits[index] |= added;
+        uint8_t queue = (added != 0) & (waiting[index] == 0);
+        stack[top] = static_cast<uint32_t>(index);
+        top += queue;
+        waiting[index] |= queue;
+    };
+
+    int x = cell % columns;
+    reach(wordIndex(cell / columns, x / 64), uint64_t(1) << (x % 64));
+    while (top > 0) {
+        // A few words at a time, so their fills overlap instead of each waiting on the last
+        const size_t BATCH = 4;
+        uint32_t batch[BATCH];
+        size_t count = min(top, BATCH);
+        top -= count;
+        copy(stack + top, stack + top + count, batch);
+
+        for (size_t i = 0; i < count; ++i) {
+            size_t index = batch[i];
+            waiting[index] = 0;
+
+            // Along the row within the word, then across into the words either side and the
+            // rows above and below. Anything new there is queued and spread from in turn.
+            uint64_t right = planes[index].right;
+            uint64_t filled = fillLeft(fillRight(filledBits[index], right), right);
+            filledBits[index] = filled;
+
+            reach(index - 1, ((filled & 1) & (planes[index - 1].right >> 63)) << 63);
+            reach(index + 1, (filled >> 63) & (right >> 63));
+            reach(index + rowWords, filled & planes[index].down);
+            reach(index - rowWords, filled & planes[index - rowWords].down);
+        }
+    }
+
+    uint64_t reachable = 0;
+    for (uint64_t word : reached) {
+        reachable += countBits(word);
+    }
+    return reachable;
+}
+
+MazeCheck WallPlanes::check() {
+    MazeCheck result;
+    uint64_t cells = static_cast<uint64_t>(columns) * rows;
+    result.borderClosed = true;
+    result.openEdges = openEdges();
+    result.reachable = floodFill(0);
+    result.treasureReachable = isReached(columns * rows - 1);
+    result.perfect = result.openEdges == cells - 1 && result.reachable == cells;
+    return result;
+}
+
+MazeCheck validateMaze(const Graph& graph, WallPlanes& planes) {
+    int columns = graph.getColumns(), rows = graph.getRows();
+    bool borderClosed = true;
+    for (int x = 0; x < columns; ++x) {
+        borderClosed &= graph.hasWall(graph.getNode(x, 0), WALL_TOP) && graph.hasWall(graph.getNode(x, rows - 1), WALL_BOTTOM);
+    }
+    for (int y = 0; y < rows; ++y) {
+        borderClosed &= graph.hasWall(graph.getNode(0, y), WALL_LEFT) && graph.hasWall(graph.getNode(columns - 1, y), WALL_RIGHT);
+    }
+
+    planes.build(graph);
+    MazeCheck result = planes.check();
+    result.borderClosed = borderClosed;
+    result.perfect = result.perfect && borderClosed;
+    return result;
+}
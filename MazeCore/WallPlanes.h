@@ -0,0 +1,81 @@
+#pragma once
+
+#include "Graph.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// What validateMaze() found. A perfect maze is one spanning tree: every cell reachable from
+// the entrance, exactly cells - 1 open walls (so no loops) and a closed outer border.
+struct MazeCheck {
+    bool borderClosed = false;
+    uint64_t openEdges = 0;
+    uint64_t reachable = 0;  // cells reachable from the entrance
+    bool treasureReachable = false;
+    bool perfect = false;
+};
+
+// The walls as bit planes: for every row, one bit per cell telling whether the wall to its
+// right is open and one whether the wall below it is, 64 cells to a word (rows start on a
+// word). Whole words of cells can then be tested, counted and flooded at once instead of a
+// cell at a time. The rows are framed by an empty row above and below and an empty word at
+// each end, so the flood fill spreads into every neighbour without checking for the edge.
+class WallPlanes {
+private:
+    struct Word {
+        uint64_t right;  // open to the right
+        uint64_t down;   // open below
+    };
+
+    int columns = 0, rows = 0;
+    size_t rowWords = 0;
+    size_t origin = 0;  // index of row 0's first word, past the frame
+    std::vector<Word> words;
+
+    // Flood fill state, per word: reached cells and whether it is waiting in pending
+    std::vector<uint64_t> reached;
+    std::vector<uint8_t> queued;
+    std::vector<uint32_t> pending;
+
+    size_t wordIndex(int y, size_t word) const { return origin + y * rowWords + word; }
+
+public:
+    // Resizes to columns x rows with every wall closed.
+    void reset(int newColumns, int newRows);
+
+    // Copies graph's right and bottom walls. Walls out through the border are left closed.
+    void build(const Graph& graph);
+
+    // Sets a word of row y from another representation. Bits past the last column, the right
+    // bit of the last column and the down bits of the last row must be clear: the flood fill
+    // relies on nothing leading out of the maze.
+    void setWord(int y, size_t word, uint64_t openRight, uint64_t openDown) {
+        Word& target = words[wordIndex(y, word)];
+        target.right = openRight;
+        target.down = openDown;
+    }
+
+    int getColumns() const { return columns; }
+    int getRows() const { return rows; }
+
+    uint64_t openEdges() const;
+
+    // Marks every cell reachable from cell and returns how many there are. Each step spreads a
+    // whole word of cells along its row and into the rows above and below. A word is stepped
+    // again each time the fill comes back to it by another way, about 15 times on average in
+    // a perfect maze, so the cost is per visit rather than per word.
+    uint64_t floodFill(int cell);
+    bool isReached(int cell) const {
+        int x = cell % columns;
+        return (reached[wordIndex(cell / columns, x / 64)] >> (x % 64)) & 1;
+    }
+
+    // Counts and floods the planes as they are (the border is taken as closed).
+    MazeCheck check();
+};
+
+// Checks graph is a perfect maze, reusing planes between calls. Measured at 5 to 14 ns per
+// cell, the most for mazes whose passages double back often (the backtracker's): about
+// 1.5 ms at 512x512, but 80 to 230 ms at 4096x4096.
+MazeCheck validateMaze(const Graph& graph, WallPlanes& planes);
@@ -0,0 +1,69 @@
+#include "WilsonGenerator.h"
+
+using namespace std;
+
+// Directions follow Graph::getNeighbors order: left, right, up, down.
+int WilsonGenerator::neighborInDirection(int cell, int direction) const {
+    switch (direction) {
+    case 0: return cell - 1;
+    case 1: return cell + 1;
+    case 2: return cell - graph.getColumns();
+    default: return cell + graph.getColumns();
+    }
+}
+
+void WilsonGenerator::beginWalk() {
+    while (scanCursor < graph.cellCount() && graph.isVisited(scanCursor)) {
+        ++scanCursor;
+    }
+    walkStart = walker = scanCursor;
+    carving = false;
+}
+
+void WilsonGenerator::start() {
+    exitDirection.assign(graph.cellCount(), 0);
+    remaining = graph.cellCount() - 1;
+    scanCursor = 0;
+
+    // The maze starts as a single random cell that the first walk has to find.
+    currentNode = rng.bounded(graph.cellCount());
+    graph.setVisited(currentNode);
+    if (remaining > 0) {
+        beginWalk();
+    }
+}
+
+bool WilsonGenerator::step() {
+    if (isDone()) {
+        return false;
+    }
+
+    if (!carving) {
+        // Overwriting the exit direction of a revisited cell is what erases the loop.
+        int neighbors[4];
+        int count = graph.getNeighbors(walker, neighbors);
+        int next = neighbors[rng.bounded(count)];
+        int delta = next - walker;
+        int columns = graph.getColumns();
+        exitDirection[walker] = delta == columns ? 3 : delta == -columns ? 2 : delta == 1 ? 1 : 0;
+        walker = currentNode = next;
+
+        if (graph.isVisited(next)) {
+            carving = true;
+            walker = walkStart;
+        }
+        return true;
+    }
+
+    int next = neighborInDirection(walker, exitDirection[walker]);
+    graph.removeWalls(walker, next);
+    graph.setVisited(walker);
+    currentNode = walker;
+    walker = next;
+    --remaining;
+
+    if (graph.isVisited(next) && remaining > 0) {
+        beginWalk();
+    }
+    return true;
+}
@@ -0,0 +1,34 @@
+#pragma once
+
+#include "MazeGenerator.h"
+
+#include <cstdint>
+#include <vector>
+
+// Wilson's algorithm: loop-erased random walks from each unvisited cell until they hit the
+// maze, then the walk is carved in. Produces a uniformly random spanning tree (no texture
+// bias at all), at the cost of long aimless walks early on. step() is one walk move or one
+// carved cell, so even the long first walk can be spread across frames.
+class WilsonGenerator : public MazeGenerator {
+private:
+    std::vector<uint8_t> exitDirection;  // per cell, the way the current walk last left it (0-3)
+    int walkStart = -1;
+    int walker = -1;
+    bool carving = false;
+    int scanCursor = 0;
+    int remaining = 0;
+
+    int neighborInDirection(int cell, int direction) const;
+    void beginWalk();
+
+protected:
+    void start() override;
+
+public:
+    explicit WilsonGenerator(Graph& graph) : MazeGenerator(graph) {}
+
+    Algorithm getAlgorithm() const override { return Algorithm::Wilson; }
+    bool isDone() const override { return remaining <= 0; }
+    bool step() override;
+    size_t workingMemoryBytes() const override { return exitDirection.capacity(); }
+};
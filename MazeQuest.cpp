@@ -1,655 +1,1273 @@
-#include <SFML/Graphics.hpp>
-#include <SFML/Audio.hpp>
-#include <ctime>
-#include <cstdlib>
-#include <map>
-#include <array>
-#include <iostream>
-#include<stack>
-
-using namespace sf;
-using namespace std;
-
-enum GameState { MAIN_MENU, HOW_TO_PLAY, START_GAME, EXIT, DIFFICULTY_SELECTION};
-
-struct Node {
-    int x, y;
-    bool visited;
-    bool walls[4]; // Top, Right, Bottom, Left walls
-
-    Node(int x, int y) : x(x), y(y), visited(false) {
-        walls[0] = walls[1] = walls[2] = walls[3] = true;
-    }
-};
-
-class Graph {
-private:
-    map<pair<int, int>, Node*> nodes;
-    int COLUMNS, ROWS;
-    Texture entranceTexture, exitTexture, visitedTexture;
-
-public:
-    Graph(int cols, int rows) : COLUMNS(cols), ROWS(rows) {
-        for (int x = 0; x < cols; ++x) {
-            for (int y = 0; y < rows; ++y) {
-                nodes[{x, y}] = new Node(x, y);
-            }
-        }
-
-        // Load textures
-        if (!exitTexture.loadFromFile("D:/TheMazeRunner/Graphics/treasure.png")) {
-            cerr << "Failed to load exit texture" << endl;
-        }
-        if (!visitedTexture.loadFromFile("D:/TheMazeRunner/Graphics/idle/body/tile005.png")) {
-            cerr << "Failed to load visited texture" << endl;
-        }
-    }
-
-    ~Graph() {
-        for (auto& pair : nodes) {
-            delete pair.second;
-        }
-    }
-
-    Node* getNode(int x, int y) const {
-        if (x >= 0 && x < COLUMNS && y >= 0 && y < ROWS) {
-            return nodes.at({ x, y });
-        }
-        return nullptr;
-    }
-
-    void removeWalls(Node* current, Node* neighbor) {
-        int dx = neighbor->x - current->x;
-        int dy = neighbor->y - current->y;
-
-        if (dx == 1) {
-            current->walls[1] = false;
-            neighbor->walls[3] = false;
-        }
-        else if (dx == -1) {
-            current->walls[3] = false;
-            neighbor->walls[1] = false;
-        }
-        else if (dy == 1) {
-            current->walls[2] = false;
-            neighbor->walls[0] = false;
-        }
-        else if (dy == -1) {
-            current->walls[0] = false;
-            neighbor->walls[2] = false;
-        }
-    }
-
-    void addNeighborsToFrontier(Node* node, Node* frontier[], int& frontierSize) {
-        static const array<pair<int, int>, 4> directions = { {{-1, 0}, {1, 0}, {0, -1}, {0, 1}} };
-
-        for (auto& dir : directions) {
-            int nx = node->x + dir.first;
-            int ny = node->y + dir.second;
-            Node* neighbor = getNode(nx, ny);
-
-            if (neighbor && !neighbor->visited) {
-                bool alreadyInFrontier = false;
-                for (int i = 0; i < frontierSize; ++i) {
-                    if (frontier[i] == neighbor) {
-                        alreadyInFrontier = true;
-                        break;
-                    }
-                }
-
-                if (!alreadyInFrontier) {
-                    frontier[frontierSize++] = neighbor;
-                }
-            }
-        }
-    }
-
-    Node* getRandomVisitedNeighbor(Node* node) {
-        static const array<pair<int, int>, 4> directions = { {{-1, 0}, {1, 0}, {0, -1}, {0, 1}} };
-        Node* visitedNeighbors[4];
-        int count = 0;
-
-        for (auto& dir : directions) {
-            int nx = node->x + dir.first;
-            int ny = node->y + dir.second;
-            Node* neighbor = getNode(nx, ny);
-
-            if (neighbor && neighbor->visited) {
-                visitedNeighbors[count++] = neighbor;
-            }
-        }
-
-        if (count > 0) {
-            return visitedNeighbors[rand() % count];
-        }
-        return nullptr;
-    }
-
-    void draw_maze(RenderWindow& window, int cellSize, Vector2f offset, Node* current = nullptr, bool generationCompleted = false) {
-        window.clear(Color::Black);
-
-        for (auto& pair : nodes) {
-            Node* node = pair.second;
-
-            int x = offset.x + node->x * cellSize;
-            int y = offset.y + node->y * cellSize;
-
-            if (node->walls[0]) drawLine(window, x, y, x + cellSize, y);
-            if (node->walls[1]) drawLine(window, x + cellSize, y, x + cellSize, y + cellSize);
-            if (node->walls[2]) drawLine(window, x, y + cellSize, x + cellSize, y + cellSize);
-            if (node->walls[3]) drawLine(window, x, y, x, y + cellSize);
-
-            if (node->x == 0 && node->y == 0) {
-                Sprite sprite(entranceTexture);
-                sprite.setPosition(x, y);
-                sprite.setScale(cellSize / static_cast<float>(entranceTexture.getSize().x),
-                    cellSize / static_cast<float>(entranceTexture.getSize().y));
-                window.draw(sprite);
-            }
-
-            if (node->x == COLUMNS - 1 && node->y == ROWS - 1) {
-                Sprite sprite(exitTexture);
-                sprite.setPosition(x, y);
-                sprite.setScale(cellSize / static_cast<float>(exitTexture.getSize().x),
-                    cellSize / static_cast<float>(exitTexture.getSize().y));
-                window.draw(sprite);
-            }
-
-            if (node == current && !generationCompleted) {
-                Sprite sprite(visitedTexture);
-                sprite.setPosition(x, y);
-                sprite.setScale(cellSize / static_cast<float>(visitedTexture.getSize().x),
-                    cellSize / static_cast<float>(visitedTexture.getSize().y));
-                window.draw(sprite);
-            }
-        }
-    }
-
-    void drawLine(RenderWindow& window, int x1, int y1, int x2, int y2) {
-        Vertex line[] = {
-            Vertex(Vector2f(x1, y1), Color::White),
-            Vertex(Vector2f(x2, y2), Color::White)
-        };
-        window.draw(line, 2, Lines);
-    }
-
-    void reset() {
-        for (auto& pair : nodes) {
-            Node* node = pair.second;
-            node->visited = false;
-            node->walls[0] = node->walls[1] = node->walls[2] = node->walls[3] = true;
-        }
-    }
-};
-
-int main() {
-    const int COLUMNS = 20;
-    const int ROWS = 10;
-    const int CELL_SIZE = 40;
-
-    GameState gameState = MAIN_MENU;
-
-    stack<Vector2i> playerPath;
-    Text movesLeftText;
-    int movesLeft = 0;
-
-    VideoMode vm(1920, 1080);
-     RenderWindow window(vm, "Maze Quest: Treasure Hunt");
-    window.setFramerateLimit(60);
-
-    Vector2f offset((vm.width - COLUMNS * CELL_SIZE) / 2.0f, (vm.height - ROWS * CELL_SIZE) / 2.0f);
-
-    Graph graph(COLUMNS, ROWS);
-
-    Node* frontier[1000];
-    int frontierSize = 0;
-
-    Node* currentNode = graph.getNode(0, 0);
-    currentNode->visited = true;
-    graph.addNeighborsToFrontier(currentNode, frontier, frontierSize);
-
-    Vector2i playerPosition(0, 0);
-    Texture playerTexture;  //load player
-    if (!playerTexture.loadFromFile("D:/TheMazeRunner/Graphics/idle/body/tile000.png")) {
-        cerr << "Failed to load player texture" << endl;
-        return -1;
-    }
-
-    Sprite playerSprite(playerTexture);
-    float scaleFactor = 2.5f;
-    playerSprite.setScale(
-        (CELL_SIZE * scaleFactor) / static_cast<float>(playerTexture.getSize().x),
-        (CELL_SIZE * scaleFactor) / static_cast<float>(playerTexture.getSize().y)
-    );
-
-    //Sound set up
-    SoundBuffer generating_maze_sound_buffer, game_start_buffer, treasure_collected_buffer, timeout_buffer;
-    Sound maze_sound, game_start_sound, treasure_collected_sound, timeout_sound;
-
-    generating_maze_sound_buffer.loadFromFile("D:/TheMazeRunner/Sound/mazegenerating.wav");
-    maze_sound.setBuffer(generating_maze_sound_buffer);
-    game_start_buffer.loadFromFile("D:/TheMazeRunner/Sound/game-start.wav");
-    game_start_sound.setBuffer(game_start_buffer);
-    treasure_collected_buffer.loadFromFile("D:/TheMazeRunner/Sound/achievement.wav");
-    treasure_collected_sound.setBuffer(treasure_collected_buffer);
-    timeout_buffer.loadFromFile("D:/TheMazeRunner/Sound/gameOver.wav.wav");
-    timeout_sound.setBuffer(timeout_buffer);
-
-    // Load font
-    Font font;
-    if (!font.loadFromFile("D:/TheMazeRunner/Font/ArcadeClassic.ttf")) {
-        cerr << "Failed to load font" << endl;
-        return -1;
-    }
-
-    Text welcomeText, playAgainText, gameStartText;
-
-    bool gameStarted = false;
-    bool welcomeDisplayed = false;
-    float welcomeStartTime = 0.0f; // Time to display the welcome message
-    float gameStartTime = 0;  // Time the message will be displayed
-
-    bool gameCompleted = false;
-    maze_sound.setLoop(true);
-    maze_sound.play();
-    game_start_sound.play();
-
-    bool upPressed = false, downPressed = false, leftPressed = false, rightPressed = false;
-
-    // MAIN MENU
-    const int MENU_ITEMS = 3;
-    Text menu[MENU_ITEMS];
-    string options[MENU_ITEMS] = { "Start Game", "How to Play", "Exit" };
-    for (int i = 0; i < MENU_ITEMS; ++i) {
-        menu[i].setFont(font);
-        menu[i].setString(options[i]);
-        menu[i].setCharacterSize(50);
-        menu[i].setFillColor(Color::White);
-        menu[i].setPosition(vm.width / 2 - menu[i].getLocalBounds().width / 2, 300 + i * 70);
-    }
-    int selectedItem = 0;
-    menu[selectedItem].setFillColor(Color::Red);
-
-    //Difficulty selection menu setup
-    const int DIFFICULTY_ITEMS = 3;
-    Text difficultyMenu[DIFFICULTY_ITEMS];
-    string difficultyOptions[DIFFICULTY_ITEMS] = { "EASY", "MEDIUM", "DIFFICULT" };
-    int selectedDifficulty = 0;
-
-    for (int i = 0; i < DIFFICULTY_ITEMS; ++i) {
-        difficultyMenu[i].setFont(font);
-        difficultyMenu[i].setString(difficultyOptions[i]);
-        difficultyMenu[i].setCharacterSize(50);
-        difficultyMenu[i].setFillColor(Color::White);
-        difficultyMenu[i].setPosition(300, 200 + i * 70);
-    }
-    difficultyMenu[selectedDifficulty].setFillColor(Color::Red);
-
-    // "How to Play" setup
-    Text howToPlayText;
-    howToPlayText.setFont(font);
-    howToPlayText.setString(
-        "Navigate  through  the  maze  to   get  to  the  treasure \n\n"
-        "Get  to  the  treasure  before  time  runs  out!!\n\n "
-        "Use  arrow  keys  to  move\n\n\n"
-        "Press  Escape  to  return  to  the  Main  Menu");
-    howToPlayText.setCharacterSize(40);
-    howToPlayText.setFillColor(Color::White);
-    howToPlayText.setPosition(200, 200);
-
-    // Set up movesLeftText properties
-    movesLeftText.setFont(font);
-    movesLeftText.setCharacterSize(40);
-    movesLeftText.setFillColor(Color::White);
-    movesLeftText.setPosition(20, 20); // Top-left corner
-
-    //Time Bar
-    RectangleShape timeBar;
-    float timeBarStartWidth = 400;
-    float timeBarHeight = 80;
-    timeBar.setSize(Vector2f(timeBarStartWidth, timeBarHeight));
-    timeBar.setFillColor(Color::Red);
-    timeBar.setOutlineThickness(5);
-    timeBar.setOutlineColor(Color::Yellow);
-    timeBar.setPosition((1920 / 2) - timeBarStartWidth / 2, 9);
-
-    bool timerStarted = false;
-    Time gameTimeTotal;
-    float timeRemaining = 30.0f;  // Start the game with 60 seconds
-    float timeBarWidthPerSecond = timeBarStartWidth / timeRemaining;
-
-    bool timeBarInitialized = false;
-    bool outOfMovesSoundPlayed = false;
-    bool outOfTimeSoundPlayed = false;
-
-    Clock gameClock;  // SFML clock to track time
-
-    while (window.isOpen()) {
-        Event event;
-        while (window.pollEvent(event)) {
-            if (event.type == Event::Closed) {
-                window.close();
-            }
-
-            if (event.type == Event::KeyReleased) {
-                if (event.key.code == Keyboard::Up) upPressed = false;
-                if (event.key.code == Keyboard::Down) downPressed = false;
-                if (event.key.code == Keyboard::Left) leftPressed = false;
-                if (event.key.code == Keyboard::Right) rightPressed = false;
-            }
-
-            if (gameState == MAIN_MENU) {
-                if (event.type == Event::KeyPressed) {
-                    if (event.key.code == Keyboard::Up) {
-                        menu[selectedItem].setFillColor(Color::White);
-                        selectedItem = (selectedItem - 1 + MENU_ITEMS) % MENU_ITEMS;
-                        menu[selectedItem].setFillColor(Color::Red);
-                    }
-                    else if (event.key.code == Keyboard::Down) {
-                        menu[selectedItem].setFillColor(Color::White);
-                        selectedItem = (selectedItem + 1) % MENU_ITEMS;
-                        menu[selectedItem].setFillColor(Color::Red);
-                    }
-                    else if (event.key.code == Keyboard::Enter) {
-                        if (selectedItem == 0)
-                            gameState = DIFFICULTY_SELECTION;
-                        else if (selectedItem == 1)
-                            gameState = HOW_TO_PLAY;
-                        else if (selectedItem == 2)
-                            window.close();
-                    }
-                }
-            }
-            else if (gameState==DIFFICULTY_SELECTION) {
-                if (event.type == Event::KeyPressed) {
-                    if (event.key.code == Keyboard::Up) {
-                        difficultyMenu[selectedDifficulty].setFillColor(Color::White);
-                        selectedDifficulty = (selectedDifficulty - 1 + DIFFICULTY_ITEMS) % DIFFICULTY_ITEMS;
-                        difficultyMenu[selectedDifficulty].setFillColor(Color::Red);
-                    }
-                    else if (event.key.code == Keyboard::Down) {
-                        difficultyMenu[selectedDifficulty].setFillColor(Color::White);
-                        selectedDifficulty = (selectedDifficulty + 1) % DIFFICULTY_ITEMS;
-                        difficultyMenu[selectedDifficulty].setFillColor(Color::Red);
-                    }
-                    else if (event.key.code == Keyboard::Enter) {
-                        if (selectedDifficulty == 0) {
-                            timeRemaining = 45.0f;
-                            movesLeft =20;
-                        }
-                        else if (selectedDifficulty == 1) {
-                            timeRemaining = 30.0f;
-                            movesLeft = 10;
-                        }
-                        else if (selectedDifficulty == 2) {
-                            timeRemaining = 20.0f;
-                            movesLeft = 5;
-                        }
-
-                        gameState = START_GAME; // Proceed to the game
-                    }
-                    else if (event.key.code == Keyboard::Escape) {
-                        gameState = MAIN_MENU; // Return to main menu
-                    }
-                }
-            }
-            
-            else if (gameState == HOW_TO_PLAY) {
-                if (event.type == Event::KeyPressed && event.key.code == Keyboard::Escape) {
-                    gameState = MAIN_MENU;
-                }
-            }
-            else if (gameState == START_GAME) {
-                if (event.type == Event::KeyPressed && event.key.code == Keyboard::Escape) {
-                    gameState = MAIN_MENU;
-                }
-            }
-        }
-        if (gameState == MAIN_MENU) {
-            window.clear();
-            for (int i = 0; i < MENU_ITEMS; ++i) {
-                window.draw(menu[i]);
-            }
-        }
-        else if (gameState == DIFFICULTY_SELECTION) {
-            for (int i = 0; i < DIFFICULTY_ITEMS; ++i) {
-                window.draw(difficultyMenu[i]);
-            }
-        
-        }
-        else if (gameState == HOW_TO_PLAY) {
-            window.clear();
-            window.draw(howToPlayText);
-        }
-        else if (gameState == START_GAME) {
-            window.clear();
-            bool mazeGenerated = false;
-
-            if (!gameCompleted) {
-                // Maze generation logic
-                if (frontierSize > 0) {
-                    int randIndex = rand() % frontierSize;
-                    currentNode = frontier[randIndex];
-                    frontier[randIndex] = frontier[--frontierSize];
-
-                    Node* visitedNeighbor = graph.getRandomVisitedNeighbor(currentNode);
-                    if (visitedNeighbor) {
-                        graph.removeWalls(currentNode, visitedNeighbor);
-                        currentNode->visited = true;
-                        graph.addNeighborsToFrontier(currentNode, frontier, frontierSize);
-                    }
-                }
-                else {
-                    mazeGenerated = true;
-                    if (!timerStarted) {
-                        timerStarted = true;  // Start the timer after maze is generated
-                        gameClock.restart();
-                    }
-                }
-
-                // Initialize time bar only once when the game starts
-                if (!timeBarInitialized) {
-                    timeBar.setSize(Vector2f(timeBarStartWidth, timeBarHeight)); // Reset time bar size
-                    timeBarInitialized = true; // Set the flag to true to prevent re-initialization
-                }
-
-                // Check if time has run out
-                if (timeRemaining <= 0) {
-                    gameCompleted = true;  // Mark game as completed
-                    timeRemaining = 0;     // Clamp time to 0
-                    treasure_collected_sound.stop(); // Ensure no treasure sound plays
-                }
-
-                // Check if moves have reached 0 (out of moves)
-                if (movesLeft <= 0) {
-                    gameCompleted = true;
-                    Text outOfMovesText;
-                    outOfMovesText.setFont(font);
-                    outOfMovesText.setString("Out of moves! \nYou Died!\n\nPress Enter to Play Again\nPress ESC to go back to Main Menu");
-                    outOfMovesText.setCharacterSize(50);
-                    outOfMovesText.setFillColor(Color::Red);
-                    outOfMovesText.setPosition(1920 / 2 - outOfMovesText.getLocalBounds().width / 2, 1080 / 2 - outOfMovesText.getLocalBounds().height / 2);
-                    window.draw(outOfMovesText);
-                }
-                else {
-                    // Movement logic 
-                    bool moved = false;
-                    if (Keyboard::isKeyPressed(Keyboard::Up) && !upPressed) {
-                        Node* current = graph.getNode(playerPosition.x, playerPosition.y);
-                        if (current && !current->walls[0]) {
-                            if (playerPath.empty() || playerPath.top() != Vector2i(playerPosition.x, playerPosition.y - 1)) {
-                                playerPath.push(playerPosition);
-                            }
-                            else {
-                                if (movesLeft > 0) {
-                                    playerPath.pop();
-                                    movesLeft--;
-                                }
-                            }
-                            playerPosition.y -= 1;
-                            moved = true;
-                        }
-                        upPressed = true;
-                    }
-
-                    if (Keyboard::isKeyPressed(Keyboard::Down) && !downPressed) {
-                        Node* current = graph.getNode(playerPosition.x, playerPosition.y);
-                        if (current && !current->walls[2]) {
-                            if (playerPath.empty() || playerPath.top() != Vector2i(playerPosition.x, playerPosition.y + 1)) {
-                                playerPath.push(playerPosition);
-                            }
-                            else {
-                                if (movesLeft > 0) {
-                                    playerPath.pop();
-                                    movesLeft--;
-                                }
-                            }
-                            playerPosition.y += 1;
-                            moved = true;
-                        }
-                        downPressed = true;
-                    }
-
-                    if (Keyboard::isKeyPressed(Keyboard::Left) && !leftPressed) {
-                        Node* current = graph.getNode(playerPosition.x, playerPosition.y);
-                        if (current && !current->walls[3]) {
-                            if (playerPath.empty() || playerPath.top() != Vector2i(playerPosition.x - 1, playerPosition.y)) {
-                                playerPath.push(playerPosition);
-                            }
-                            else {
-                                if (movesLeft > 0) {
-                                    playerPath.pop();
-                                    movesLeft--;
-                                }
-                            }
-                            playerPosition.x -= 1;
-                            moved = true;
-                        }
-                        leftPressed = true;
-                    }
-
-                    if (Keyboard::isKeyPressed(Keyboard::Right) && !rightPressed) {
-                        Node* current = graph.getNode(playerPosition.x, playerPosition.y);
-                        if (current && !current->walls[1]) {
-                            if (playerPath.empty() || playerPath.top() != Vector2i(playerPosition.x + 1, playerPosition.y)) {
-                                playerPath.push(playerPosition);
-                            }
-                            else {
-                                if (movesLeft > 0) {
-                                    playerPath.pop();
-                                    movesLeft--;
-                                }
-                            }
-                            playerPosition.x += 1;
-                            moved = true;
-                        }
-                        rightPressed = true;
-                    }
-
-                    // Check if player reaches the treasure
-                    if (movesLeft > 0 && playerPosition.x == COLUMNS - 1 && playerPosition.y == ROWS - 1) {
-                        treasure_collected_sound.play();
-                        gameCompleted = true; // Set game to completed when treasure is reached
-                    }
-
-                    movesLeftText.setString("Moves  Left=  " + std::to_string(movesLeft));
-
-                    // Drawing the maze and player sprite
-                    graph.draw_maze(window, CELL_SIZE, offset, currentNode, frontierSize == 0);
-                    playerSprite.setPosition(
-                        offset.x + playerPosition.x * CELL_SIZE - (CELL_SIZE * (scaleFactor - 1)) / 2,
-                        offset.y + playerPosition.y * CELL_SIZE - (CELL_SIZE * (scaleFactor - 1)) / 2
-                    );
-                    window.draw(playerSprite);
-                    window.draw(movesLeftText);
-                }
-            }
-            else {
-                // Handle Game Over scenarios (either out of moves or out of time)
-                if (movesLeft <= 0) {
-                    if (!outOfMovesSoundPlayed) {
-                        timeout_sound.play();
-                        outOfMovesSoundPlayed = true; // Set the flag so the sound only plays once
-                    }
-                    Text outOfMovesText;
-                    outOfMovesText.setFont(font);
-                    outOfMovesText.setString("Out  of  moves! \nYou  Died!\n\nPress  Enter  to  Play  Again\nPress  ESC  to  go  back  to  Main  Menu");
-                    outOfMovesText.setCharacterSize(50);
-                    outOfMovesText.setFillColor(Color::Red);
-                    outOfMovesText.setPosition(1920 / 2 - outOfMovesText.getLocalBounds().width / 2, 1080 / 2 - outOfMovesText.getLocalBounds().height / 2);
-                    window.draw(outOfMovesText);
-                }
-                else if (timeRemaining <= 0) {
-                    if (!outOfTimeSoundPlayed) {
-                        timeout_sound.play();
-                        outOfTimeSoundPlayed = true; // Set the flag so the sound only plays once
-                    }
-                    Text outOfTimeText;
-                    outOfTimeText.setFont(font);
-                    outOfTimeText.setString("You  Are  Out  of  Time!!\nYou Died!\n\nPress  Enter  to  Play  Again\nPress  ESC  to  go  back  to  Main  Menu");
-                    outOfTimeText.setCharacterSize(50);
-                    outOfTimeText.setFillColor(Color::Red);
-                    outOfTimeText.setPosition(1920 / 2 - outOfTimeText.getLocalBounds().width / 2, 1080 / 2 - outOfTimeText.getLocalBounds().height / 2);
-                    window.draw(outOfTimeText);
-                }
-                else {
-                    Text winText;
-                    winText.setFont(font);
-                    winText.setString("Congratulations!! You won!\n\nPress  Enter  to  Play  Again!\nPress  ESC  to  go  back  to  Main  Menu");
-                    winText.setCharacterSize(50);
-                    winText.setFillColor(Color::White);
-                    winText.setPosition(1920 / 2 - winText.getLocalBounds().width / 2, 1080 / 2 - winText.getLocalBounds().height / 2);
-                    window.draw(winText);
-                }
-
-                // Key input to restart or go back to main menu
-                if (Keyboard::isKeyPressed(Keyboard::Enter)) {
-                    // Reset game state
-                    graph.reset();
-                    frontierSize = 0;
-                    currentNode = graph.getNode(0, 0);
-                    currentNode->visited = true;
-                    graph.addNeighborsToFrontier(currentNode, frontier, frontierSize);
-                    playerPosition = Vector2i(0, 0);
-                    gameCompleted = false;
-                    movesLeft = 20;  // Reset moves
-                    timeRemaining = 30.0f; // Reset time
-                    outOfMovesSoundPlayed = false;
-                    outOfTimeSoundPlayed = false;
-                    if (!timeBarInitialized) {
-                        // Initialize the time bar only once when the game starts or restarts
-                        timeBar.setSize(Vector2f(timeBarStartWidth, timeBarHeight)); // Reset time bar size
-                        timeBarInitialized = true; // Set flag to true to avoid re-initialization
-                    }
-
-                    maze_sound.play();
-                    timerStarted = false; // Reset the timer start flag
-                    gameState = DIFFICULTY_SELECTION;
-                }
-
-                if (Keyboard::isKeyPressed(Keyboard::Escape)) {
-                    gameState = MAIN_MENU;
-                }
-            }
-
-            // Update time only if the timer has started
-            if (mazeGenerated && timerStarted) {
-                float deltaTime = gameClock.restart().asSeconds();
-                timeRemaining -= deltaTime;
-
-                if (timeRemaining < 0) timeRemaining = 0;  // Clamp time to zero
-
-                timeBar.setSize(Vector2f(timeBarStartWidth * (timeRemaining / 30.0f), timeBarHeight)); // Update time bar size
-            }
-
-            // Draw the time bar after updating it
-            window.draw(timeBar);
-        }
-        window.display();
-    }
-
-    return 0;
-}
-
-
-
+#include <SFML/Graphics.hpp>
+#include <SFML/Audio.hpp>
+#include <ctime>
+#include <cerrno>
+#include <cstdlib>
+#include <algorithm>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <new>
+#include <random>
+#include <string>
+#include <memory>
+#include <thread>
+
+#include "MazeCore/AgentSwarm.h"
+#include "MazeCore/BakedLevels.h"
+#include "MazeCore/GameSession.h"
+#include "MazeCore/Graph.h"
+#include "MazeCore/MazeFile.h"
+#include "MazeCore/MazeGenerator.h"
+#include "MazeCore/MazePool.h"
+#include "MazeCore/Profiler.h"
+#include "MazeCore/Replay.h"
+#include "MazeCore/SavedMazeGenerator.h"
+#include "MazeCore/Solver.h"
+#include "MazeCore/TripleBuffer.h"
+#include "MazeCore/WallPlanes.h"
+#include "AssetManager.h"
+#include "MazeRenderer.h"
+#include "EndlessMode.h"
+#include "ProfilerOverlay.h"
+
+using namespace sf;
+using namespace std;
+
+#ifdef _DEBUG
+// Debug builds count every heap allocation so we can check that a steady-state
+// gameplay frame allocates nothing. Reset per frame from the main loop. The counts are per
+// thread, so the render thread and the workers (maze pool, chunks, rivals) do not show up in
+// the main loop's check.
+namespace allocStats {
+    thread_local size_t count = 0;
+    thread_local size_t bytes = 0;
+}
+
+void* operator new(size_t size) {
+    ++allocStats::count;
+    allocStats::bytes += size;
+    if (void* p = malloc(size ? size : 1)) {
+        return p;
+    }
+    throw bad_alloc();
+}
+
+void operator delete(void* p) noexcept {
+    free(p);
+}
+
+void operator delete(void* p, size_t) noexcept {
+    free(p);
+}
+#endif
+
+enum GameState { MAIN_MENU, HOW_TO_PLAY, START_GAME, EXIT, DIFFICULTY_SELECTION, ENDLESS_GAME};
+
+// The parts of a frame the profiler times. "display" includes the wait for the frame limiter.
+enum FramePhase { PHASE_EVENTS, PHASE_GENERATE, PHASE_SIMULATE, PHASE_DRAW_MAZE, PHASE_HUD, PHASE_DISPLAY };
+
+// The parts of a frame on the render thread, which draws rounds.
+enum RenderPhase { RENDER_SYNC, RENDER_DRAW_MAZE, RENDER_HUD, RENDER_DISPLAY };
+
+// An arrow key press waiting for the simulation, stamped with when the event loop read it.
+struct TimedMove {
+    Move move;
+    Profiler::Clock::time_point readAt;
+};
+
+// Everything the render thread needs to draw one frame of a round, published by the main
+// thread after each simulation step. Plain values only, so publishing never allocates.
+struct RoundSnapshot {
+    int playerX = 0, playerY = 0;
+    int undosLeft = 0;
+    float timeShare = 1.0f;  // share of the round's time still left
+    SessionState state = SessionState::Waiting;
+    bool over = false;
+    int generatorCell = -1;
+    bool generated = false;
+    size_t carves = 0;       // the walls are the first `carves` entries of the carve log
+    View view;
+    float scale = 1.0f;      // screen pixels per world unit at the camera's zoom
+    bool showHint = false;
+    bool showProfiler = false;
+    float ticksPerSecond = 0;
+    uint64_t moves = 0;      // moves applied this round, and when the newest was read
+    Profiler::Clock::time_point lastMoveReadAt;
+    std::vector<uint32_t> rivals;  // each rival's cell, copied only when they have moved
+    uint64_t rivalsVersion = 0;
+    size_t rivalsHome = 0;
+};
+
+// How much maze generation the game loop runs per frame. A limit of 0 means "no limit", so
+// { 0, Time::Zero } generates the whole maze at once. The generator only draws random numbers
+// inside step(), so every budget produces the same maze; only the animation differs.
+struct GenerationBudget {
+    int maxSteps;
+    Time maxTime;
+};
+
+// Resumes the generator where the previous frame left it and stops when the budget is spent.
+// Returns the number of cells carved this frame.
+int advanceGeneration(MazeGenerator& generator, const GenerationBudget& budget) {
+    Clock clock;
+    int steps = 0;
+
+    while (!generator.isDone()) {
+        generator.step();
+        ++steps;
+
+        if (budget.maxSteps > 0 && steps >= budget.maxSteps) {
+            break;
+        }
+        // Reading the clock costs more than a step, so only check it every few dozen cells.
+        if (budget.maxTime > Time::Zero && steps % 32 == 0 && clock.getElapsedTime() >= budget.maxTime) {
+            break;
+        }
+    }
+    return steps;
+}
+
+// The solver's distance field is built a slice at a time too, so a big maze never stalls a frame.
+// Returns true once the field is complete.
+bool advanceSolve(Solver& solver, Time maxTime) {
+    Clock clock;
+    while (!solver.advanceDistances(4096)) {
+        if (clock.getElapsedTime() >= maxTime) {
+            return false;
+        }
+    }
+    return true;
+}
+
+// Roughly what a Text submits: two triangles per character.
+size_t textVertices(const Text& text) {
+    return text.getString().getSize() * 6;
+}
+
+// Game-over overlays are laid out once up front; only their visibility changes per frame.
+void setupOverlayText(Text& text, const Font& font, const string& message, Color color) {
+    text.setFont(font);
+    text.setString(message);
+    text.setCharacterSize(50);
+    text.setFillColor(color);
+    text.setPosition(1920 / 2 - text.getLocalBounds().width / 2, 1080 / 2 - text.getLocalBounds().height / 2);
+}
+
+// The most cells a maze can have in the game, e.g. 8192x8192. Cell and edge ids stay well
+// inside an int, and the grid, solver and wall planes together stay around a gigabyte.
+const int64_t MAX_CELLS = int64_t(1) << 26;
+
+void printUsage() {
+    cerr << "usage: MazeQuest [--seed N] [--size WxH] [--maze FILE [--level N]] [--tutorial | --daily]\n"
+            "                 [--trace FILE] [--uncapped] [--slow-render MS] [--replay-dir DIR] [--assets PATH]" << endl;
+}
+
+// Reads all of text as a decimal number in [low, high]; false for anything else.
+bool parseNumber(const string& text, long long low, long long high, long long& value) {
+    char* end = nullptr;
+    errno = 0;
+    value = strtoll(text.c_str(), &end, 10);
+    return !text.empty() && *end == '\0' && errno == 0 && value >= low && value <= high;
+}
+
+// Fresh seed for mazes the player did not ask for by number.
+uint64_t randomSeed() {
+    return (static_cast<uint64_t>(random_device{}()) << 32) ^ static_cast<uint64_t>(time(nullptr));
+}
+
+int main(int argc, char* argv[]) {
+    Clock startupClock;  // for the time to the first frame
+    int COLUMNS = 20;
+    int ROWS = 10;
+    const int CELL_SIZE = 40;
+
+    // --seed <n> replays a specific maze (decimal or 0x-prefixed hex); otherwise every maze is new.
+    // --size <W>x<H> plays a bigger (or smaller) maze; the camera follows the player around it.
+    // --trace <file> records every frame phase and writes a Chrome trace there on exit.
+    // --uncapped renders as fast as possible instead of waiting for vsync.
+    // --slow-render <ms> stalls every rendered frame of a round, to check the simulation keeps its rate.
+    // --maze <file> [--level <n>] plays a saved maze, or maze n of a level pack, instead of a new one.
+    // --replay-dir <dir> is where every round's replay is saved (default "replays").
+    // --assets <dir or pack> loads the fonts, images and sounds from there (see AssetManager.h).
+    // --tutorial or --daily plays a level built into the game (see BakedLevels.h).
+    uint64_t mazeSeed = randomSeed();
+    string tracePath;
+    string mazePath;
+    string replayDir = "replays";
+    string assetPath;
+    size_t level = 0;
+    const BakedLevel* bakedLevel = nullptr;
+    bool uncapped = false;
+    Time slowRender;
+    for (int i = 1; i < argc; ++i) {
+        if (string(argv[i]) == "--uncapped") {
+            uncapped = true;
+        }
+        else if (string(argv[i]) == "--tutorial") {
+            bakedLevel = &tutorialLevel();
+        }
+        else if (string(argv[i]) == "--daily") {
+            bakedLevel = &dailyLevel(time(nullptr) / (24 * 60 * 60));
+        }
+        if (i + 1 >= argc) {
+            break;
+        }
+        if (string(argv[i]) == "--seed") {
+            char* end = nullptr;
+            errno = 0;
+            mazeSeed = strtoull(argv[i + 1], &end, 0);
+            if (*argv[i + 1] == '\0' || *argv[i + 1] == '-' || *end != '\0' || errno != 0) {
+                cerr << "--seed needs a number, not '" << argv[i + 1] << "'" << endl;
+                printUsage();
+                return 1;
+            }
+        }
+        else if (string(argv[i]) == "--size") {
+            string size = argv[i + 1];
+            size_t x = size.find('x');
+            long long columns = 0, rows = 0;
+            if (!parseNumber(size.substr(0, x), 2, MAX_CELLS / 2, columns)
+                || !parseNumber(x == string::npos ? size : size.substr(x + 1), 2, MAX_CELLS / 2, rows)
+                || columns * rows > MAX_CELLS) {
+                cerr << "--size needs W or WxH, each at least 2 and at most " << MAX_CELLS << " cells in all, not '" << size << "'" << endl;
+                printUsage();
+                return 1;
+            }
+            COLUMNS = static_cast<int>(columns);
+            ROWS = static_cast<int>(rows);
+        }
+        else if (string(argv[i]) == "--trace") {
+            tracePath = argv[i + 1];
+        }
+        else if (string(argv[i]) == "--slow-render") {
+            long long stall = 0;
+            if (!parseNumber(argv[i + 1], 0, 10000, stall)) {
+                cerr << "--slow-render needs milliseconds from 0 to 10000, not '" << argv[i + 1] << "'" << endl;
+                printUsage();
+                return 1;
+            }
+            slowRender = milliseconds(static_cast<int>(stall));
+        }
+        else if (string(argv[i]) == "--maze") {
+            mazePath = argv[i + 1];
+        }
+        else if (string(argv[i]) == "--level") {
+            long long index = 0;
+            if (!parseNumber(argv[i + 1], 0, INT32_MAX, index)) {
+                cerr << "--level needs a maze number, not '" << argv[i + 1] << "'" << endl;
+                printUsage();
+                return 1;
+            }
+            level = static_cast<size_t>(index);
+        }
+        else if (string(argv[i]) == "--replay-dir") {
+            replayDir = argv[i + 1];
+        }
+        else if (string(argv[i]) == "--assets") {
+            assetPath = argv[i + 1];
+        }
+    }
+
+    // Images and sound effects are decoded on worker threads while the window opens and the
+    // menu runs; only the font is waited for.
+    AssetManager assets;
+    if (!assets.open(assetPath, argv[0])) {
+        cerr << "Failed to find the game's assets: no assets.mqas or Font, Graphics and Sound folders "
+            << "beside the executable or in the working directory, and no --assets or MAZEQUEST_ASSETS" << endl;
+        return -1;
+    }
+    assets.startLoading(static_cast<int>(thread::hardware_concurrency()));
+
+    // A saved maze brings its own size, seed and algorithm. Its passages are copied out of the
+    // mapped file, so the pack is closed again straight away.
+    MazeInfo savedInfo;
+    vector<uint32_t> savedEdges;
+    if (!mazePath.empty()) {
+        MazePack pack;
+        if (!pack.open(mazePath) || level >= pack.mazeCount()
+            || !readMazeInfo(pack.mazeData(level), pack.mazeSize(level), savedInfo)
+            || !readMazeEdges(pack.mazeData(level), pack.mazeSize(level), savedEdges)) {
+            cerr << "Failed to load maze " << level << " from " << mazePath << endl;
+            return -1;
+        }
+        COLUMNS = savedInfo.width;
+        ROWS = savedInfo.height;
+        if (static_cast<int64_t>(COLUMNS) * ROWS > MAX_CELLS) {
+            cerr << "Maze " << level << " of " << mazePath << " is too big to play: " << COLUMNS << "x" << ROWS << endl;
+            return -1;
+        }
+    }
+    else if (bakedLevel) {
+        // Already in the binary: only its carve order is copied, for playback like a saved maze
+        savedInfo.width = bakedLevel->columns;
+        savedInfo.height = bakedLevel->rows;
+        savedInfo.seed = bakedLevel->seed;
+        savedInfo.algorithm = Algorithm::Backtracker;
+        savedEdges.assign(bakedLevel->carveLog, bakedLevel->carveLog + bakedLevel->carves);
+        COLUMNS = savedInfo.width;
+        ROWS = savedInfo.height;
+        cout << "Playing " << bakedLevel->name << " (seed " << bakedLevel->seed << ")" << endl;
+    }
+    bool savedMaze = !mazePath.empty() || bakedLevel;
+
+    GameState gameState = MAIN_MENU;
+
+    Text movesLeftText;
+    int movesLeft = 0;
+
+    VideoMode vm(1920, 1080);
+     RenderWindow window(vm, "Maze Quest: Treasure Hunt");
+    // Gameplay runs in fixed ticks, so the render rate is free to follow the display (or not).
+    window.setVerticalSyncEnabled(!uncapped);
+
+    Vector2f offset((vm.width - COLUMNS * CELL_SIZE) / 2.0f, (vm.height - ROWS * CELL_SIZE) / 2.0f);
+
+    // The maze is drawn through a camera that follows the player; the mouse wheel or +/- zoom.
+    // Once a cell is only a few pixels on screen the wall lines give way to a texture.
+    MazeCamera camera(Vector2f(static_cast<float>(vm.width), static_cast<float>(vm.height)),
+        FloatRect(offset.x, offset.y, static_cast<float>(COLUMNS * CELL_SIZE), static_cast<float>(ROWS * CELL_SIZE)));
+    const float ZOOM_STEP = 1.25f;
+    const float LOD_CELL_PIXELS = 4.0f;
+
+    // F3 shows the profiler overlay.
+    Profiler profiler({ "events", "generate", "simulate", "draw_maze", "hud", "display" });
+    Profiler renderProfiler({ "sync", "draw_maze", "hud", "display" }, "render");
+    if (!tracePath.empty()) {
+        profiler.startTrace(1 << 20);  // about 30 minutes at 60 fps
+        renderProfiler.startTrace(1 << 20);
+    }
+    bool showProfiler = false;
+
+    Graph graph(COLUMNS, ROWS);
+
+    graph.setCarveLogging(true);
+    Algorithm selectedAlgorithm = Algorithm::Prim;
+    unique_ptr<MazeGenerator> generator;
+    if (!savedMaze) {
+        generator = makeGenerator(selectedAlgorithm, graph, mazeSeed);
+    }
+    else {
+        // Built like a generated maze, so it animates and plays the same way
+        selectedAlgorithm = savedInfo.algorithm;
+        generator.reset(new SavedMazeGenerator(graph, savedInfo.algorithm, move(savedEdges)));
+        generator->reset(savedInfo.seed);
+    }
+
+    // Mazes for "play again" are built in the background while a round is played (see
+    // MazePool.h), so the next round can start on a finished one. A saved maze is just replayed.
+    unique_ptr<MazePool> mazePool;
+    PooledMaze pooledMaze;
+    bool generatorPooled = false;  // generator plays back a pooled maze's carve order
+    bool freshMaze = false;        // the next round wants a new random maze
+    if (!savedMaze) {
+        // A pooled maze holds 4 bytes a cell, so past a million cells only one is kept ahead
+        size_t poolDepth = graph.cellCount() > (1 << 20) ? 1 : MazePool::DEFAULT_DEPTH;
+        mazePool.reset(new MazePool(COLUMNS, ROWS, randomSeed(), poolDepth));
+        mazePool->prepare(selectedAlgorithm);
+    }
+
+    // Animate generation over about two seconds whatever the maze size, but never let it take
+    // more than 4 ms of a frame. G switches to building the whole maze in a single frame. For a
+    // pooled maze the animation is a replay of the order its walls were carved in.
+    const float GENERATION_SECONDS = 2.0f;
+    const GenerationBudget ANIMATED_GENERATION = { max(1, static_cast<int>(static_cast<int64_t>(COLUMNS) * ROWS / (GENERATION_SECONDS * 60))), milliseconds(4) };
+    const GenerationBudget INSTANT_GENERATION = { 0, Time::Zero };
+    GenerationBudget generationBudget = ANIMATED_GENERATION;
+
+    // Rounds are drawn on their own thread from a copy of the maze, which it brings up to date
+    // by replaying the carve log up to where each snapshot says the walls are final.
+    Graph renderGraph(COLUMNS, ROWS);
+    renderGraph.setCarveLogging(true);
+    MazeRenderer mazeRenderer(renderGraph);
+    WallMesh wallMesh(renderGraph, CELL_SIZE);
+    wallMesh.setPosition(offset);
+    WallTexture wallTexture(renderGraph, CELL_SIZE);
+    wallTexture.setPosition(offset);
+
+    // The distance field is rooted at the treasure: its value at the entrance is the solution
+    // length, and walking it downhill from the player is the hint. H toggles the hint.
+    Solver solver(graph);
+    bool solverStarted = false;
+    const Time SOLVE_TIME = milliseconds(4);
+
+    // Every maze is checked to be perfect on a worker while the solver runs, and the round waits
+    // for both. The graph is not touched until the check is joined.
+    WallPlanes wallPlanes;
+    MazeCheck mazeCheck;
+    thread checkThread;
+    atomic<bool> checkDone{ false };
+    auto finishCheck = [&]() {
+        if (checkThread.joinable()) {
+            checkThread.join();
+        }
+    };
+    PathOverlay hintOverlay(renderGraph, CELL_SIZE);
+    hintOverlay.setPosition(offset);
+    vector<int> hintPath;
+    bool showHint = false;
+
+    // Rivals race the player to the treasure once the round starts (see AgentSwarm.h). They
+    // move at 60 Hz and never end the round; they only decide where a win places the player.
+    const size_t RIVAL_COUNTS[] = { 0, 1000, 10000, 100000 };
+    const int RIVAL_SETTINGS = 4;
+    const int SWARM_TICKS = GameSession::TICK_RATE / 60;
+    int rivalSetting = 0;
+    AgentSwarm swarm(graph);
+    uint64_t swarmVersion = 0;  // bumped whenever the rivals are moved or replaced
+    SwarmOverlay swarmOverlay(renderGraph, CELL_SIZE);
+    swarmOverlay.setPosition(offset);
+
+    // The player's texture, and the sound effects' buffers, arrive with the rest of the assets (applyAssets below)
+    Sprite playerSprite;
+    float scaleFactor = 2.5f;
+
+    //Sound set up
+    Sound game_start_sound, treasure_collected_sound, timeout_sound;
+
+    // The generation music loops for as long as the game runs, so it is streamed rather than
+    // decoded into memory whole
+    Music maze_music;
+    bool musicOpen = assets.openMusic(maze_music);
+
+    // Load font
+    Font font;
+    if (!assets.loadFont(font)) {
+        cerr << "Failed to load font" << endl;
+        return -1;
+    }
+    ProfilerOverlay profilerOverlay(font);
+
+    // Called once the images and sound effects are in. The menus run without them; a round
+    // waits for them (they are nearly always in long before anyone gets through the menus).
+    int exitCode = 0;
+    auto applyAssets = [&]() {
+        if (!assets.hasTexture(TextureAsset::Player)) {
+            cerr << "Failed to load player texture" << endl;
+            exitCode = -1;
+            window.close();
+            return false;
+        }
+        const Texture& playerTexture = assets.texture(TextureAsset::Player);
+        playerSprite.setTexture(playerTexture, true);
+        playerSprite.setScale(
+            (CELL_SIZE * scaleFactor) / static_cast<float>(playerTexture.getSize().x),
+            (CELL_SIZE * scaleFactor) / static_cast<float>(playerTexture.getSize().y)
+        );
+        mazeRenderer.setTextures(assets.texture(TextureAsset::Treasure), assets.texture(TextureAsset::Visited));
+
+        game_start_sound.setBuffer(assets.sound(SoundAsset::GameStart));
+        treasure_collected_sound.setBuffer(assets.sound(SoundAsset::Treasure));
+        timeout_sound.setBuffer(assets.sound(SoundAsset::GameOver));
+        game_start_sound.play();
+
+        cout << "Assets from " << assets.getSource() << " loaded in " << assets.getLoadTime().asMilliseconds()
+            << " ms: sound effects hold " << assets.soundBytes() / 1024 << " KB";
+        if (musicOpen) {
+            // What a SoundBuffer would have held for the music, against about a second of it streamed
+            float seconds = maze_music.getDuration().asSeconds();
+            size_t samplesPerSecond = static_cast<size_t>(maze_music.getSampleRate()) * maze_music.getChannelCount();
+            cout << ", the music streams " << samplesPerSecond * sizeof(Int16) / 1024 << " KB at a time instead of "
+                << static_cast<size_t>(seconds * samplesPerSecond) * sizeof(Int16) / 1024 << " KB";
+        }
+        cout << endl;
+        return true;
+    };
+
+    Text welcomeText, playAgainText, gameStartText;
+
+    bool gameStarted = false;
+    bool welcomeDisplayed = false;
+    float welcomeStartTime = 0.0f; // Time to display the welcome message
+    float gameStartTime = 0;  // Time the message will be displayed
+
+    if (musicOpen) {
+        maze_music.setLoop(true);
+        maze_music.play();
+    }
+
+
+    // MAIN MENU
+    const int MENU_ITEMS = 3;
+    Text menu[MENU_ITEMS];
+    string options[MENU_ITEMS] = { "Start Game", "How to Play", "Exit" };
+    for (int i = 0; i < MENU_ITEMS; ++i) {
+        menu[i].setFont(font);
+        menu[i].setString(options[i]);
+        menu[i].setCharacterSize(50);
+        menu[i].setFillColor(Color::White);
+        menu[i].setPosition(vm.width / 2 - menu[i].getLocalBounds().width / 2, 300 + i * 70);
+    }
+    int selectedItem = 0;
+    menu[selectedItem].setFillColor(Color::Red);
+
+    //Difficulty selection menu setup
+    const int DIFFICULTY_ITEMS = 4;
+    const int ENDLESS_ITEM = 3;
+    Text difficultyMenu[DIFFICULTY_ITEMS];
+    string difficultyOptions[DIFFICULTY_ITEMS] = { "EASY", "MEDIUM", "DIFFICULT", "ENDLESS" };
+    int selectedDifficulty = 0;
+
+    for (int i = 0; i < DIFFICULTY_ITEMS; ++i) {
+        difficultyMenu[i].setFont(font);
+        difficultyMenu[i].setString(difficultyOptions[i]);
+        difficultyMenu[i].setCharacterSize(50);
+        difficultyMenu[i].setFillColor(Color::White);
+        difficultyMenu[i].setPosition(300, 200 + i * 70);
+    }
+    difficultyMenu[selectedDifficulty].setFillColor(Color::Red);
+
+    // Left/Right picks the generation algorithm; it is applied when the game starts. A saved or
+    // baked maze is played as it is, so it shows its algorithm without the arrows.
+    Text algorithmText;
+    algorithmText.setFont(font);
+    algorithmText.setCharacterSize(40);
+    algorithmText.setFillColor(Color::White);
+    algorithmText.setPosition(300, 200 + DIFFICULTY_ITEMS * 70 + 30);
+    algorithmText.setString(savedMaze ? string("Maze   ") + algorithmName(selectedAlgorithm)
+        : string("Maze   <  ") + algorithmName(selectedAlgorithm) + "  >");
+
+    // G, here or during generation, switches between watching the maze being built and not.
+    Text generationText;
+    generationText.setFont(font);
+    generationText.setCharacterSize(40);
+    generationText.setFillColor(Color::White);
+    generationText.setPosition(300, 200 + DIFFICULTY_ITEMS * 70 + 90);
+    auto toggleGeneration = [&](bool animated) {
+        generationBudget = animated ? ANIMATED_GENERATION : INSTANT_GENERATION;
+        generationText.setString(animated ? "G   Build   ANIMATED" : "G   Build   INSTANT");
+    };
+    toggleGeneration(true);
+
+    // R cycles how many rivals the next round has.
+    Text rivalsText;
+    rivalsText.setFont(font);
+    rivalsText.setCharacterSize(40);
+    rivalsText.setFillColor(Color::White);
+    rivalsText.setPosition(300, 200 + DIFFICULTY_ITEMS * 70 + 150);
+    auto showRivalSetting = [&]() {
+        size_t rivals = RIVAL_COUNTS[rivalSetting];
+        rivalsText.setString(rivals == 0 ? string("R   Rivals   OFF") : "R   Rivals   " + to_string(rivals));
+    };
+    showRivalSetting();
+
+    // "How to Play" setup
+    Text howToPlayText;
+    howToPlayText.setFont(font);
+    howToPlayText.setString(
+        "Navigate  through  the  maze  to   get  to  the  treasure \n\n"
+        "Get  to  the  treasure  before  time  runs  out!!\n\n "
+        "Use  arrow  keys  to  move\n\n\n"
+        "Press  Escape  to  return  to  the  Main  Menu");
+    howToPlayText.setCharacterSize(40);
+    howToPlayText.setFillColor(Color::White);
+    howToPlayText.setPosition(200, 200);
+
+    // Set up movesLeftText properties
+    movesLeftText.setFont(font);
+    movesLeftText.setCharacterSize(40);
+    movesLeftText.setFillColor(Color::White);
+    movesLeftText.setPosition(20, 20); // Top-left corner
+
+    // The seed only changes when a new maze starts, so it is laid out then and not per frame.
+    Text seedText;
+    seedText.setFont(font);
+    seedText.setCharacterSize(30);
+    seedText.setFillColor(Color::White);
+    seedText.setPosition(20, 70);
+    seedText.setString("Seed  " + to_string(generator->getSeed()));
+
+    // How many rivals are home, or where a win placed the player among them.
+    Text raceText;
+    raceText.setFont(font);
+    raceText.setCharacterSize(30);
+    raceText.setFillColor(Color::White);
+    raceText.setPosition(20, 110);
+
+    // Endless mode only exists while it is being played; its chunk cache goes with it.
+    unique_ptr<EndlessMode> endless;
+    Text endlessText, endlessStatsText;
+    endlessText.setFont(font);
+    endlessText.setCharacterSize(30);
+    endlessText.setFillColor(Color::White);
+    endlessText.setPosition(20, 20);
+    endlessStatsText.setFont(font);
+    endlessStatsText.setCharacterSize(30);
+    endlessStatsText.setFillColor(Color::White);
+    endlessStatsText.setPosition(20, 70);
+    size_t shownEndlessChunks = SIZE_MAX;  // chunk count currently laid out in endlessStatsText
+
+    Text outOfMovesText, outOfTimeText, winText;
+    setupOverlayText(outOfMovesText, font, "Out  of  moves! \nYou  Died!\n\nPress  Enter  to  Play  Again\nPress  ESC  to  go  back  to  Main  Menu", Color::Red);
+    setupOverlayText(outOfTimeText, font, "You  Are  Out  of  Time!!\nYou Died!\n\nPress  Enter  to  Play  Again\nPress  ESC  to  go  back  to  Main  Menu", Color::Red);
+    setupOverlayText(winText, font, "Congratulations!! You won!\n\nPress  Enter  to  Play  Again!\nPress  ESC  to  go  back  to  Main  Menu", Color::White);
+
+    //Time Bar
+    RectangleShape timeBar;
+    float timeBarStartWidth = 400;
+    float timeBarHeight = 80;
+    timeBar.setSize(Vector2f(timeBarStartWidth, timeBarHeight));
+    timeBar.setFillColor(Color::Red);
+    timeBar.setOutlineThickness(5);
+    timeBar.setOutlineColor(Color::Yellow);
+    timeBar.setPosition((1920 / 2) - timeBarStartWidth / 2, 9);
+
+    Time gameTimeTotal;
+    float timeLimit = 30.0f;  // length of the current round, set from the solution length
+
+    bool outOfMovesSoundPlayed = false;
+    bool outOfTimeSoundPlayed = false;
+
+    // The round itself. Arrow key events are queued with the time they were read and handed to
+    // the session by fixed ticks of GameSession::TICK_RATE, however fast frames are drawn.
+    GameSession session(graph);
+    const Time TICK = microseconds(1000000 / GameSession::TICK_RATE);
+    const Time MAX_FRAME_TIME = milliseconds(250);  // after a stall, skip ahead instead of running a burst of ticks
+    Clock frameClock;
+    Time frameTime, simulationLag;
+    vector<TimedMove> pendingMoves;
+    pendingMoves.reserve(64);
+    float generationCredit = 0;  // generation steps earned but not yet run
+    uint64_t movesApplied = 0;
+    Profiler::Clock::time_point lastMoveReadAt;
+    Clock tickRateClock;
+    int ticksCounted = 0;
+    float ticksPerSecond = 0;
+
+    // The menus and a finished round look the same until a key is pressed, so they are drawn
+    // once when they change and the loop then blocks in waitEvent() instead of redrawing them
+    // every frame. Anything animated (a round being built or played, endless mode, the F3
+    // overlay) keeps drawing at the display rate.
+    bool screenDirty = true;
+    bool firstFrameShown = false;
+    auto isStaticScreen = [&]() {
+        return gameState == MAIN_MENU || gameState == HOW_TO_PLAY || gameState == DIFFICULTY_SELECTION
+            || (gameState == START_GAME && session.isOver());
+    };
+
+    // Every round is recorded as the moves made on each tick and saved when it ends (or is
+    // abandoned), so it can be checked or watched again with mazereplay.
+    Replay replay;
+    replay.events.reserve(1 << 16);  // room for any real round, so recording never allocates mid-game
+    bool replayPending = false;
+    auto saveReplay = [&]() {
+        if (!replayPending) {
+            return;
+        }
+        replayPending = false;
+        replay.outcome = session.getState();
+        replay.ticksPlayed = session.getTicksPlayed();
+
+        string bytes;
+        appendReplay(bytes, replay);
+        error_code error;
+        filesystem::create_directories(replayDir, error);
+        string path = replayDir + "/maze-" + to_string(replay.seed) + "-" + to_string(time(nullptr)) + ".mqrp";
+        ofstream file(path, ios::binary);
+        if (!file.write(bytes.data(), bytes.size())) {
+            cerr << "Failed to save replay to " << path << endl;
+        }
+    };
+
+    TripleBuffer<RoundSnapshot> snapshots;
+    mutex snapshotMutex;
+    condition_variable snapshotPublished;
+    auto wakeRenderer = [&]() {
+        // Taking the lock puts the publish before a waiting render thread's check, so the wakeup is never lost.
+        { lock_guard<mutex> lock(snapshotMutex); }
+        snapshotPublished.notify_one();
+    };
+    auto publishSnapshot = [&]() {
+        camera.follow(Vector2f(offset.x + (session.getX() + 0.5f) * CELL_SIZE, offset.y + (session.getY() + 0.5f) * CELL_SIZE));
+        RoundSnapshot& snapshot = snapshots.back();
+        snapshot.playerX = session.getX();
+        snapshot.playerY = session.getY();
+        snapshot.state = session.getState();
+        snapshot.over = session.isOver();
+        snapshot.undosLeft = session.getState() == SessionState::Waiting ? movesLeft : session.getUndosLeft();
+        snapshot.timeShare = session.getState() == SessionState::Waiting ? 1.0f : session.getSecondsLeft() / session.getTimeLimit();
+        snapshot.generatorCell = generator->getCurrentNode();
+        snapshot.generated = generator->isDone();
+        snapshot.carves = graph.getCarveLog().size();
+        snapshot.view = camera.getView();
+        snapshot.scale = camera.getScale();
+        snapshot.showHint = showHint;
+        snapshot.showProfiler = showProfiler;
+        snapshot.ticksPerSecond = ticksPerSecond;
+        snapshot.moves = movesApplied;
+        snapshot.lastMoveReadAt = lastMoveReadAt;
+        snapshot.rivals.reserve(RIVAL_COUNTS[rivalSetting]);  // in place before the round plays, so it never allocates then
+        if (snapshot.rivalsVersion != swarmVersion) {
+            snapshot.rivals.assign(swarm.getCells().begin(), swarm.getCells().end());
+            snapshot.rivalsVersion = swarmVersion;
+        }
+        snapshot.rivalsHome = swarm.arrivedCount();
+        snapshots.publish();
+        wakeRenderer();
+    };
+
+    // The render thread lives for the length of a round. While it runs it owns the window's
+    // context and everything it draws (the copy of the maze, the wall layers, the HUD), and it
+    // only learns about the round through snapshots, so it never waits on the simulation or
+    // holds it up. The solver is read for hints only once the round is playing, when the
+    // distance field is complete and no longer written.
+    atomic<bool> rendering{ false };
+    thread renderThread;
+    auto renderRound = [&]() {
+        window.setActive(true);
+        renderGraph.reset();
+        size_t replayedCarves = 0;
+        int shownMovesLeft = -1;  // undo count currently laid out in movesLeftText
+        int hintCell = -1;        // player cell the hint overlay was built for
+        bool hintShown = false;
+        size_t shownRivalsHome = SIZE_MAX;  // rivals home currently laid out in raceText
+        bool shownPlacing = false;
+        uint64_t presentedMoves = 0;
+
+        while (rendering) {
+            // A finished round's frame is drawn once; after that the thread sleeps until
+            // something new is published (or the round is left) rather than drawing it again.
+            if (!snapshots.fetch() && snapshots.front().over) {
+                unique_lock<mutex> lock(snapshotMutex);
+                snapshotPublished.wait(lock, [&]() { return !rendering || snapshots.fetch(); });
+                if (!rendering) {
+                    break;
+                }
+            }
+            renderProfiler.beginFrame();
+            ScopedPhase syncPhase(renderProfiler, RENDER_SYNC);
+            const RoundSnapshot& frame = snapshots.front();
+            const vector<uint32_t>& carveLog = graph.getCarveLog();
+            for (; replayedCarves < frame.carves; ++replayedCarves) {
+                renderGraph.carveEdge(carveLog[replayedCarves]);
+            }
+            WallLayer& walls = CELL_SIZE * frame.scale < LOD_CELL_PIXELS ? static_cast<WallLayer&>(wallTexture) : wallMesh;
+            walls.sync();
+            syncPhase.stop();
+
+            window.clear();
+            if (!frame.over) {
+                // Drawing the maze and player sprite
+                ScopedPhase drawPhase(renderProfiler, RENDER_DRAW_MAZE);
+                window.setView(frame.view);
+                DrawCounts mazeDraws = mazeRenderer.draw_maze(window, walls, CELL_SIZE, offset, frame.generatorCell, frame.generated);
+                renderProfiler.countDraws(mazeDraws.drawCalls, mazeDraws.vertices);
+                if (slowRender > Time::Zero) {
+                    sleep(slowRender);
+                }
+                drawPhase.stop();
+
+                ScopedPhase hudPhase(renderProfiler, RENDER_HUD);
+                playerSprite.setPosition(
+                    offset.x + frame.playerX * CELL_SIZE - (CELL_SIZE * (scaleFactor - 1)) / 2,
+                    offset.y + frame.playerY * CELL_SIZE - (CELL_SIZE * (scaleFactor - 1)) / 2
+                );
+                if (frame.showHint != hintShown) {
+                    hintShown = frame.showHint;
+                    hintCell = -1;
+                    hintOverlay.clear();
+                }
+                if (frame.showHint && frame.state == SessionState::Playing) {
+                    int playerCell = renderGraph.getNode(frame.playerX, frame.playerY);
+                    if (playerCell != hintCell) {
+                        solver.pathToSource(playerCell, hintPath);
+                        hintOverlay.setPath(hintPath);
+                        hintCell = playerCell;
+                    }
+                    window.draw(hintOverlay);
+                    renderProfiler.countDraws(1, hintOverlay.vertexCount());
+                }
+                if (!frame.rivals.empty()) {
+                    FloatRect visible(frame.view.getCenter() - frame.view.getSize() / 2.0f, frame.view.getSize());
+                    swarmOverlay.setAgents(frame.rivals, visible);
+                    window.draw(swarmOverlay);
+                    renderProfiler.countDraws(1, swarmOverlay.vertexCount());
+                }
+                window.draw(playerSprite);
+                window.setView(window.getDefaultView());
+                if (frame.undosLeft != shownMovesLeft) {
+                    movesLeftText.setString("Moves  Left=  " + std::to_string(frame.undosLeft));
+                    shownMovesLeft = frame.undosLeft;
+                }
+                window.draw(movesLeftText);
+                window.draw(seedText);
+                renderProfiler.countDraws(3, 4 + textVertices(movesLeftText) + textVertices(seedText));
+            }
+            else if (frame.state == SessionState::OutOfMoves) {
+                window.draw(outOfMovesText);
+            }
+            else if (frame.state == SessionState::OutOfTime) {
+                window.draw(outOfTimeText);
+            }
+            else {
+                window.draw(winText);
+            }
+            if (!frame.rivals.empty()) {
+                bool placing = frame.state == SessionState::Won;
+                if (frame.rivalsHome != shownRivalsHome || placing != shownPlacing) {
+                    raceText.setString(placing
+                        ? "You  came  " + to_string(frame.rivalsHome + 1) + "  of  " + to_string(frame.rivals.size() + 1)
+                        : "Rivals  home  " + to_string(frame.rivalsHome) + "  /  " + to_string(frame.rivals.size()));
+                    shownRivalsHome = frame.rivalsHome;
+                    shownPlacing = placing;
+                }
+                window.draw(raceText);
+                renderProfiler.countDraws(1, textVertices(raceText));
+            }
+
+            // The time bar shows the share of this round's limit that is left
+            ScopedPhase hudPhase(renderProfiler, RENDER_HUD);
+            timeBar.setSize(Vector2f(timeBarStartWidth * frame.timeShare, timeBarHeight));
+            window.draw(timeBar);
+            renderProfiler.countDraws(1, timeBar.getPointCount() + 2);
+            if (frame.showProfiler) {
+                profilerOverlay.update(renderProfiler, frame.ticksPerSecond);
+                window.draw(profilerOverlay);
+            }
+            hudPhase.stop();
+
+            ScopedPhase displayPhase(renderProfiler, RENDER_DISPLAY);
+            window.display();
+            displayPhase.stop();
+
+            // Input latency: from reading a key event to the display() of the frame showing the move.
+            if (frame.moves != presentedMoves) {
+                renderProfiler.addInputLatency(Profiler::Clock::now() - frame.lastMoveReadAt);
+                presentedMoves = frame.moves;
+            }
+            renderProfiler.endFrame();
+        }
+        window.setActive(false);
+    };
+
+    auto startRendering = [&]() {
+        movesApplied = 0;
+        publishSnapshot();
+        window.setActive(false);
+        rendering = true;
+        renderThread = thread(renderRound);
+    };
+    auto stopRendering = [&]() {
+        if (renderThread.joinable()) {
+            rendering = false;
+            wakeRenderer();
+            renderThread.join();
+            window.setActive(true);
+        }
+    };
+
+    while (window.isOpen()) {
+#ifdef _DEBUG
+        allocStats::count = 0;
+        allocStats::bytes = 0;
+#endif
+
+        // Nothing on a static screen changes until an event arrives, so wait for one. The time
+        // spent waiting is not a frame, for the profiler or for the generation animation.
+        if (assets.update()) {
+            applyAssets();
+        }
+        Event event;
+        bool woken = !screenDirty && !showProfiler && assets.isLoaded() && isStaticScreen() && window.waitEvent(event);
+        if (woken) {
+            frameClock.restart();
+        }
+        profiler.beginFrame();
+        frameTime = min(frameClock.restart(), MAX_FRAME_TIME);
+
+        ScopedPhase eventsPhase(profiler, PHASE_EVENTS);
+        for (bool more = woken || window.pollEvent(event); more; more = window.pollEvent(event)) {
+            if (event.type == Event::KeyPressed || event.type == Event::MouseWheelScrolled
+                || event.type == Event::Resized || event.type == Event::GainedFocus) {
+                screenDirty = true;
+            }
+            if (event.type == Event::Closed) {
+                saveReplay();
+                stopRendering();
+                window.close();
+            }
+            if (event.type == Event::KeyPressed && event.key.code == Keyboard::F3) {
+                showProfiler = !showProfiler;
+            }
+
+            if (gameState == MAIN_MENU) {
+                if (event.type == Event::KeyPressed) {
+                    if (event.key.code == Keyboard::Up) {
+                        menu[selectedItem].setFillColor(Color::White);
+                        selectedItem = (selectedItem - 1 + MENU_ITEMS) % MENU_ITEMS;
+                        menu[selectedItem].setFillColor(Color::Red);
+                    }
+                    else if (event.key.code == Keyboard::Down) {
+                        menu[selectedItem].setFillColor(Color::White);
+                        selectedItem = (selectedItem + 1) % MENU_ITEMS;
+                        menu[selectedItem].setFillColor(Color::Red);
+                    }
+                    else if (event.key.code == Keyboard::Enter) {
+                        if (selectedItem == 0)
+                            gameState = DIFFICULTY_SELECTION;
+                        else if (selectedItem == 1)
+                            gameState = HOW_TO_PLAY;
+                        else if (selectedItem == 2)
+                            window.close();
+                    }
+                }
+            }
+            else if (gameState==DIFFICULTY_SELECTION) {
+                if (event.type == Event::KeyPressed && event.key.code == Keyboard::Enter && assets.finishLoading() && !applyAssets()) {
+                    break;
+                }
+                if (event.type == Event::KeyPressed) {
+                    if (event.key.code == Keyboard::Up) {
+                        difficultyMenu[selectedDifficulty].setFillColor(Color::White);
+                        selectedDifficulty = (selectedDifficulty - 1 + DIFFICULTY_ITEMS) % DIFFICULTY_ITEMS;
+                        difficultyMenu[selectedDifficulty].setFillColor(Color::Red);
+                    }
+                    else if (event.key.code == Keyboard::Down) {
+                        difficultyMenu[selectedDifficulty].setFillColor(Color::White);
+                        selectedDifficulty = (selectedDifficulty + 1) % DIFFICULTY_ITEMS;
+                        difficultyMenu[selectedDifficulty].setFillColor(Color::Red);
+                    }
+                    else if (!savedMaze && (event.key.code == Keyboard::Left || event.key.code == Keyboard::Right)) {
+                        int step = event.key.code == Keyboard::Right ? 1 : ALGORITHM_COUNT - 1;
+                        selectedAlgorithm = static_cast<Algorithm>((static_cast<int>(selectedAlgorithm) + step) % ALGORITHM_COUNT);
+                        algorithmText.setString(string("Maze   <  ") + algorithmName(selectedAlgorithm) + "  >");
+                        if (mazePool) {
+                            mazePool->prepare(selectedAlgorithm);
+                        }
+                    }
+                    else if (event.key.code == Keyboard::G) {
+                        toggleGeneration(generationBudget.maxSteps == 0);
+                    }
+                    else if (event.key.code == Keyboard::R) {
+                        rivalSetting = (rivalSetting + 1) % RIVAL_SETTINGS;
+                        showRivalSetting();
+                    }
+                    else if (event.key.code == Keyboard::Enter && selectedDifficulty == ENDLESS_ITEM) {
+                        // No timer and no treasure: the maze just keeps going in every direction.
+                        uint64_t worldSeed = freshMaze ? randomSeed() : generator->getSeed();
+                        endless.reset(new EndlessMode(worldSeed, selectedAlgorithm, CELL_SIZE, playerSprite, scaleFactor));
+                        endlessText.setString("Seed  " + to_string(endless->getSeed()));
+                        shownEndlessChunks = SIZE_MAX;
+                        gameState = ENDLESS_GAME;
+                    }
+                    else if (event.key.code == Keyboard::Enter) {
+                        finishCheck();  // an abandoned round's check may still be reading the graph
+                        if (freshMaze && mazePool->take(selectedAlgorithm, pooledMaze)) {
+                            // Already built: generation plays its carve log back, all at once or animated
+                            generator.reset(new SavedMazeGenerator(graph, pooledMaze.algorithm, move(pooledMaze.carveLog)));
+                            generator->reset(pooledMaze.seed);
+                            generatorPooled = true;
+                        }
+                        else if (!savedMaze && (generatorPooled || generator->getAlgorithm() != selectedAlgorithm)) {
+                            // Same seed, different algorithm (or nothing pooled yet): the maze is rebuilt before generation starts.
+                            generator = makeGenerator(selectedAlgorithm, graph, freshMaze ? randomSeed() : generator->getSeed());
+                            generatorPooled = false;
+                        }
+                        else if (freshMaze) {
+                            generator->reset(randomSeed());
+                        }
+                        freshMaze = false;
+                        seedText.setString("Seed  " + to_string(generator->getSeed()));
+
+                        // Until the maze is built and solved the round gets the minimum budget;
+                        // it is recalibrated to the real solution length before the clock starts.
+                        calibrateRound(DIFFICULTY_LEVELS[selectedDifficulty], 0, timeLimit, movesLeft);
+                        session.reset();
+                        pendingMoves.clear();
+                        outOfMovesSoundPlayed = false;
+                        outOfTimeSoundPlayed = false;
+                        solverStarted = false;
+                        swarm.reset(0, 0, 0, 0);
+                        ++swarmVersion;
+
+                        startRendering();
+                        gameState = START_GAME; // Proceed to the game
+                    }
+                    else if (event.key.code == Keyboard::Escape) {
+                        gameState = MAIN_MENU; // Return to main menu
+                    }
+                }
+            }
+            
+            else if (gameState == HOW_TO_PLAY) {
+                if (event.type == Event::KeyPressed && event.key.code == Keyboard::Escape) {
+                    gameState = MAIN_MENU;
+                }
+            }
+            else if (gameState == ENDLESS_GAME) {
+                if (event.type == Event::KeyPressed && event.key.code == Keyboard::Escape) {
+                    endless.reset();
+                    gameState = MAIN_MENU;
+                }
+                else if (event.type == Event::KeyPressed) {
+                    endless->handleKey(event.key.code);
+                }
+            }
+            else if (gameState == START_GAME) {
+                if (event.type == Event::KeyPressed && event.key.code == Keyboard::Escape) {
+                    saveReplay();
+                    stopRendering();
+                    gameState = MAIN_MENU;
+                }
+                else if (event.type == Event::KeyPressed && (event.key.code == Keyboard::Up || event.key.code == Keyboard::Down
+                    || event.key.code == Keyboard::Left || event.key.code == Keyboard::Right)) {
+                    Move move = event.key.code == Keyboard::Up ? Move::Up
+                        : event.key.code == Keyboard::Down ? Move::Down
+                        : event.key.code == Keyboard::Left ? Move::Left : Move::Right;
+                    pendingMoves.push_back({ move, Profiler::Clock::now() });
+                }
+                else if (event.type == Event::KeyPressed && event.key.code == Keyboard::Enter && session.isOver()) {
+                    // Play again: a fresh maze (or the same saved one), then back to the difficulty screen.
+                    // A fresh one is picked when the round starts, from the pool if one is ready, and
+                    // is put in place at once unless G asks to watch it built.
+                    stopRendering();
+                    if (mazePool) {
+                        freshMaze = true;
+                        toggleGeneration(false);
+                    }
+                    else {
+                        generator->reset(generator->getSeed());
+                    }
+                    session.reset();
+                    if (musicOpen) {
+                        maze_music.play();
+                    }
+                    solverStarted = false;
+                    gameState = DIFFICULTY_SELECTION;
+                }
+                else if (event.type == Event::KeyPressed && event.key.code == Keyboard::G) {
+                    toggleGeneration(generationBudget.maxSteps == 0);
+                }
+                else if (event.type == Event::MouseWheelScrolled) {
+                    camera.zoomBy(event.mouseWheelScroll.delta > 0 ? 1 / ZOOM_STEP : ZOOM_STEP);
+                }
+                else if (event.type == Event::KeyPressed && (event.key.code == Keyboard::Add || event.key.code == Keyboard::Equal)) {
+                    camera.zoomBy(1 / ZOOM_STEP);
+                }
+                else if (event.type == Event::KeyPressed && (event.key.code == Keyboard::Subtract || event.key.code == Keyboard::Hyphen)) {
+                    camera.zoomBy(ZOOM_STEP);
+                }
+                else if (event.type == Event::KeyPressed && event.key.code == Keyboard::H) {
+                    showHint = !showHint;
+                }
+            }
+        }
+        eventsPhase.stop();
+
+        bool redraw = screenDirty || showProfiler || !isStaticScreen();
+        screenDirty = false;
+        if (!redraw) {
+            // Static and unchanged: the last frame presented is still right.
+        }
+        else if (gameState == MAIN_MENU) {
+            window.clear();
+            for (int i = 0; i < MENU_ITEMS; ++i) {
+                window.draw(menu[i]);
+            }
+        }
+        else if (gameState == DIFFICULTY_SELECTION) {
+            window.clear();
+            for (int i = 0; i < DIFFICULTY_ITEMS; ++i) {
+                window.draw(difficultyMenu[i]);
+            }
+            window.draw(algorithmText);
+            window.draw(generationText);
+            window.draw(rivalsText);
+        }
+        else if (gameState == HOW_TO_PLAY) {
+            window.clear();
+            window.draw(howToPlayText);
+        }
+        else if (gameState == ENDLESS_GAME) {
+            endless->update();
+            endless->draw(window);
+
+            size_t chunks = endless->loadedChunks();
+            if (chunks != shownEndlessChunks) {
+                shownEndlessChunks = chunks;
+                endlessStatsText.setString("Chunks  " + to_string(chunks));
+            }
+            window.draw(endlessText);
+            window.draw(endlessStatsText);
+        }
+        else if (gameState == START_GAME) {
+            // The render thread draws the round from the snapshots published here, so this thread
+            // only builds, solves and simulates, and a slow frame never holds up a tick.
+            if (!session.isOver()) {
+                // Maze generation logic, paced by real time so the animation takes as long at any loop rate
+                ScopedPhase generatePhase(profiler, PHASE_GENERATE);
+                if (!generator->isDone()) {
+                    GenerationBudget budget = generationBudget;
+                    if (budget.maxSteps > 0) {
+                        // The loop runs faster than 60 Hz, so whole steps are handed out and the
+                        // fraction carried over rather than rounding every loop up to a step
+                        generationCredit += budget.maxSteps * frameTime.asSeconds() * 60;
+                        budget.maxSteps = static_cast<int>(generationCredit);
+                        generationCredit -= budget.maxSteps;
+                    }
+                    if (budget.maxSteps > 0 || generationBudget.maxSteps == 0) {
+                        advanceGeneration(*generator, budget);
+                    }
+                }
+                else if (session.getState() == SessionState::Waiting) {
+                    if (!solverStarted) {
+                        finishCheck();
+                        checkDone = false;
+                        checkThread = thread([&] {
+                            mazeCheck = validateMaze(graph, wallPlanes);
+                            checkDone = true;
+                        });
+                        solver.startDistances(graph.getNode(COLUMNS - 1, ROWS - 1));
+                        solverStarted = true;
+                    }
+                    // Start the round once the maze is generated, checked and solved
+                    if (advanceSolve(solver, SOLVE_TIME) && checkDone) {
+                        finishCheck();
+                        if (!mazeCheck.perfect) {
+                            cerr << "Maze " << generator->getSeed() << " is not perfect: " << mazeCheck.openEdges << " open walls, "
+                                << mazeCheck.reachable << " of " << graph.cellCount() << " cells reachable" << endl;
+                        }
+                        calibrateRound(DIFFICULTY_LEVELS[selectedDifficulty], solver.distanceTo(graph.getNode(0, 0)), timeLimit, movesLeft);
+                        session.start(timeLimit, movesLeft);
+                        simulationLag = Time::Zero;
+                        // The rivals set off from the entrance with the player, on paths drawn from the maze's seed
+                        swarm.reset(RIVAL_COUNTS[rivalSetting], graph.getNode(0, 0), graph.getNode(COLUMNS - 1, ROWS - 1), generator->getSeed());
+                        ++swarmVersion;
+
+                        // A saved maze may not come out of its seed again, so its replay carries it
+                        replay.width = COLUMNS;
+                        replay.height = ROWS;
+                        replay.seed = generator->getSeed();
+                        replay.algorithm = generator->getAlgorithm();
+                        replay.difficulty = selectedDifficulty;
+                        replay.timeLimit = timeLimit;
+                        replay.undos = movesLeft;
+                        replay.events.clear();
+                        replay.mazeFile.clear();
+                        if (!mazePath.empty()) {
+                            MazeInfo info;
+                            info.seed = replay.seed;
+                            info.algorithm = replay.algorithm;
+                            info.solutionLength = solver.distanceTo(graph.getNode(0, 0));
+                            appendMazeFile(replay.mazeFile, graph, info);
+                        }
+                        replayPending = true;
+                    }
+                }
+                generatePhase.stop();
+
+                // Fixed-timestep simulation: run every whole tick the real time since the last frame
+                // covers. Each tick applies the moves read before its end on the input clock; the
+                // frame's last tick also takes any read after it, so a move is never held back a
+                // frame just because it arrived between tick boundaries.
+                ScopedPhase simulatePhase(profiler, PHASE_SIMULATE);
+                simulationLag += frameTime;
+                int ticks = static_cast<int>(simulationLag.asMicroseconds() / TICK.asMicroseconds());
+                simulationLag -= TICK * static_cast<Int64>(ticks);
+                Profiler::Clock::time_point lastTickEnd = Profiler::Clock::now() - chrono::microseconds(simulationLag.asMicroseconds());
+                size_t nextMove = 0;
+                for (int tick = 0; tick < ticks; ++tick) {
+                    Profiler::Clock::time_point tickEnd = lastTickEnd - chrono::microseconds(TICK.asMicroseconds() * (ticks - 1 - tick));
+                    for (; nextMove < pendingMoves.size() && (tick == ticks - 1 || pendingMoves[nextMove].readAt <= tickEnd); ++nextMove) {
+                        if (session.getState() == SessionState::Playing) {
+                            replay.events.push_back({ session.getTicksPlayed(), pendingMoves[nextMove].move });
+                        }
+                        if (session.move(pendingMoves[nextMove].move)) {
+                            ++movesApplied;
+                            lastMoveReadAt = pendingMoves[nextMove].readAt;
+                        }
+                    }
+                    session.tick();
+                    if (session.getState() == SessionState::Playing && session.getTicksPlayed() % SWARM_TICKS == 0
+                        && swarm.arrivedCount() < swarm.agentCount()) {
+                        swarm.step();
+                        ++swarmVersion;
+                    }
+                }
+                pendingMoves.erase(pendingMoves.begin(), pendingMoves.begin() + nextMove);
+                ticksCounted += ticks;
+
+                if (session.getState() == SessionState::Won) {
+                    treasure_collected_sound.play();
+                }
+                simulatePhase.stop();
+                if (session.isOver()) {
+                    saveReplay();
+                    screenDirty = true;  // the finished screen (and its sound) still has to go out
+                }
+            }
+            // Handle Game Over scenarios (either out of moves or out of time)
+            else if (session.getState() == SessionState::OutOfMoves && !outOfMovesSoundPlayed) {
+                timeout_sound.play();
+                outOfMovesSoundPlayed = true; // Set the flag so the sound only plays once
+            }
+            else if (session.getState() == SessionState::OutOfTime && !outOfTimeSoundPlayed) {
+                treasure_collected_sound.stop(); // Ensure no treasure sound plays
+                timeout_sound.play();
+                outOfTimeSoundPlayed = true; // Set the flag so the sound only plays once
+            }
+
+            if (tickRateClock.getElapsedTime() >= seconds(1)) {
+                ticksPerSecond = ticksCounted / tickRateClock.restart().asSeconds();
+                ticksCounted = 0;
+            }
+            publishSnapshot();
+        }
+
+        // The pool gives the core back while this thread builds or solves a maze of its own.
+        if (mazePool) {
+            mazePool->setPaused(gameState == START_GAME && session.getState() == SessionState::Waiting);
+        }
+
+        if (redraw && gameState != START_GAME) {
+            if (showProfiler) {
+                ScopedPhase hudPhase(profiler, PHASE_HUD);
+                profilerOverlay.update(profiler);
+                window.draw(profilerOverlay);
+            }
+
+            ScopedPhase displayPhase(profiler, PHASE_DISPLAY);
+            window.display();
+            displayPhase.stop();
+            if (!firstFrameShown) {
+                firstFrameShown = true;
+                cout << "First frame after " << startupClock.getElapsedTime().asMilliseconds() << " ms" << endl;
+            }
+        }
+        profiler.endFrame();
+
+#ifdef _DEBUG
+        // Once the maze is built and the round is running, a main loop frame should not touch the heap.
+        // The profiler overlay rebuilds its text now and then, so it is left out of the check.
+        if (gameState == START_GAME && session.getState() == SessionState::Playing && !showProfiler && allocStats::count > 0) {
+            cerr << "Gameplay frame allocated " << allocStats::bytes << " bytes in "
+                << allocStats::count << " allocations" << endl;
+        }
+#endif
+
+        // During a round nothing on this thread waits for the display, so it paces itself to the tick rate.
+        if (gameState == START_GAME) {
+            Time spent = frameClock.getElapsedTime();
+            if (spent < TICK) {
+                sleep(TICK - spent);
+            }
+        }
+    }
+    stopRendering();
+    finishCheck();
+    if (mazePool && mazePool->rejectedCount() > 0) {
+        cerr << "Maze pool dropped " << mazePool->rejectedCount() << " mazes that were not perfect" << endl;
+    }
+
+    if (profiler.tracing() && !Profiler::writeTrace(tracePath, { &profiler, &renderProfiler })) {
+        cerr << "Failed to write trace to " << tracePath << endl;
+    }
+    return exitCode;
+}
+
+
+
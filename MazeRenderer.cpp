@@ -0,0 +1,417 @@
+#include "MazeRenderer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+using namespace sf;
+using namespace std;
+
+WallMesh::WallMesh(const Graph& graph, float cellSize)
+    : graph(graph), cellSize(cellSize), useBuffer(VertexBuffer::isAvailable()) {
+}
+
+void WallMesh::setLine(Vertex* vertices, Vector2f from, Vector2f to, Color color) {
+    vertices[0] = Vertex(from, color);
+    vertices[1] = Vertex(to, color);
+}
+
+void WallMesh::rebuild() {
+    int columns = graph.getColumns(), rows = graph.getRows();
+    tileColumns = (columns + TILE_SIZE - 1) / TILE_SIZE;
+    tileRows = (rows + TILE_SIZE - 1) / TILE_SIZE;
+    tiles.clear();
+    tiles.resize(static_cast<size_t>(tileColumns) * tileRows);
+    builtTiles.clear();
+    setLine(border, Vector2f(0, 0), Vector2f(columns * cellSize, 0), Color::White);
+    setLine(border + 2, Vector2f(0, 0), Vector2f(0, rows * cellSize), Color::White);
+
+    built = true;
+    syncedEpoch = graph.getEpoch();
+    syncedCarves = graph.getCarveLog().size();
+}
+
+unique_ptr<WallMesh::Tile> WallMesh::buildTile(int tileX, int tileY) const {
+    unique_ptr<Tile> tile(new Tile());
+    tile->left = tileX * TILE_SIZE;
+    tile->top = tileY * TILE_SIZE;
+    tile->columns = min(TILE_SIZE, graph.getColumns() - tile->left);
+    tile->rows = min(TILE_SIZE, graph.getRows() - tile->top);
+    tile->vertices.resize(static_cast<size_t>(tile->columns) * tile->rows * 4);
+
+    for (int y = 0; y < tile->rows; ++y) {
+        for (int x = 0; x < tile->columns; ++x) {
+            int cell = graph.getNode(tile->left + x, tile->top + y);
+            Vertex* vertices = &tile->vertices[(static_cast<size_t>(y) * tile->columns + x) * 4];
+            float left = (tile->left + x) * cellSize, top = (tile->top + y) * cellSize;
+            float right = left + cellSize, bottom = top + cellSize;
+            setLine(vertices, Vector2f(right, top), Vector2f(right, bottom),
+                graph.hasWall(cell, WALL_RIGHT) ? Color::White : Color::Transparent);
+            setLine(vertices + 2, Vector2f(left, bottom), Vector2f(right, bottom),
+                graph.hasWall(cell, WALL_BOTTOM) ? Color::White : Color::Transparent);
+        }
+    }
+
+    if (useBuffer) {
+        tile->buffer.setPrimitiveType(Lines);
+        tile->buffer.setUsage(VertexBuffer::Dynamic);
+        tile->buffer.create(tile->vertices.size());
+        tile->buffer.update(tile->vertices.data());
+    }
+    return tile;
+}
+
+void WallMesh::drawRange(RenderTarget& target, const RenderStates& states, const Tile& tile, size_t first, size_t count) const {
+    if (useBuffer) {
+        target.draw(tile.buffer, first, count, states);
+    }
+    else {
+        target.draw(&tile.vertices[first], count, Lines, states);
+    }
+    ++lastDraw.drawCalls;
+    lastDraw.vertices += count;
+}
+
+void WallMesh::draw(RenderTarget& target, RenderStates states) const {
+    lastDraw = DrawCounts();
+    if (!built) {
+        return;
+    }
+    states.transform *= getTransform();
+
+    // The view's rectangle in mesh coordinates, widened by a cell so walls on its edges stay.
+    const View& view = target.getView();
+    FloatRect visible(view.getCenter().x - view.getSize().x / 2, view.getCenter().y - view.getSize().y / 2,
+        view.getSize().x, view.getSize().y);
+    visible = states.transform.getInverse().transformRect(visible);
+    int columns = graph.getColumns(), rows = graph.getRows();
+    int firstColumn = max(0, static_cast<int>(floor(visible.left / cellSize)) - 1);
+    int lastColumn = min(columns - 1, static_cast<int>(floor((visible.left + visible.width) / cellSize)) + 1);
+    int firstRow = max(0, static_cast<int>(floor(visible.top / cellSize)) - 1);
+    int lastRow = min(rows - 1, static_cast<int>(floor((visible.top + visible.height) / cellSize)) + 1);
+
+    if (firstColumn <= lastColumn && firstRow <= lastRow) {
+        int firstTileX = firstColumn / TILE_SIZE, lastTileX = lastColumn / TILE_SIZE;
+        int firstTileY = firstRow / TILE_SIZE, lastTileY = lastRow / TILE_SIZE;
+        for (int tileY = firstTileY; tileY <= lastTileY; ++tileY) {
+            for (int tileX = firstTileX; tileX <= lastTileX; ++tileX) {
+                int index = tileY * tileColumns + tileX;
+                if (!tiles[index]) {
+                    tiles[index] = buildTile(tileX, tileY);
+                    builtTiles.push_back(index);
+                }
+                const Tile& tile = *tiles[index];
+                int fromColumn = max(firstColumn, tile.left) - tile.left, toColumn = min(lastColumn, tile.left + tile.columns - 1) - tile.left;
+                int fromRow = max(firstRow, tile.top) - tile.top, toRow = min(lastRow, tile.top + tile.rows - 1) - tile.top;
+                if (fromColumn == 0 && toColumn == tile.columns - 1) {
+                    drawRange(target, states, tile, static_cast<size_t>(fromRow) * tile.columns * 4, static_cast<size_t>(toRow - fromRow + 1) * tile.columns * 4);
+                }
+                else {
+                    for (int row = fromRow; row <= toRow; ++row) {
+                        drawRange(target, states, tile, (static_cast<size_t>(row) * tile.columns + fromColumn) * 4, static_cast<size_t>(toColumn - fromColumn + 1) * 4);
+                    }
+                }
+            }
+        }
+
+        // Tiles more than a tile away from the view are dropped; they are rebuilt if it comes back.
+        for (size_t i = 0; i < builtTiles.size();) {
+            int tileX = builtTiles[i] % tileColumns, tileY = builtTiles[i] / tileColumns;
+            if (tileX < firstTileX - 1 || tileX > lastTileX + 1 || tileY < firstTileY - 1 || tileY > lastTileY + 1) {
+                tiles[builtTiles[i]].reset();
+                builtTiles[i] = builtTiles.back();
+                builtTiles.pop_back();
+            }
+            else {
+                ++i;
+            }
+        }
+    }
+    target.draw(border, 4, Lines, states);
+    ++lastDraw.drawCalls;
+    lastDraw.vertices += 4;
+}
+
+void WallMesh::sync() {
+    if (!built || syncedEpoch != graph.getEpoch()) {
+        rebuild();
+        return;
+    }
+
+    const vector<uint32_t>& log = graph.getCarveLog();
+    size_t pending = log.size() - syncedCarves;
+    if (pending == 0) {
+        return;
+    }
+
+    // Past a few thousand edges one upload of each touched tile beats many small ones.
+    // Walls in tiles that are not built are skipped: a tile is built from the graph as it is.
+    bool uploadAll = pending > 4096;
+    int columns = graph.getColumns();
+    for (size_t i = syncedCarves; i < log.size(); ++i) {
+        int cell = static_cast<int>(log[i] / 2);
+        int x = cell % columns, y = cell / columns;
+        Tile* tile = tiles[(y / TILE_SIZE) * tileColumns + x / TILE_SIZE].get();
+        if (!tile) {
+            continue;
+        }
+        size_t first = (static_cast<size_t>(y - tile->top) * tile->columns + (x - tile->left)) * 4 + (log[i] % 2) * 2;
+        tile->vertices[first].color = tile->vertices[first + 1].color = Color::Transparent;
+        if (useBuffer && !uploadAll) {
+            tile->buffer.update(&tile->vertices[first], 2, static_cast<unsigned>(first));
+        }
+        tile->dirty = true;
+    }
+    for (int index : builtTiles) {
+        Tile& tile = *tiles[index];
+        if (tile.dirty && useBuffer && uploadAll) {
+            tile.buffer.update(tile.vertices.data());
+        }
+        tile.dirty = false;
+    }
+    syncedCarves = log.size();
+}
+
+WallTexture::WallTexture(const Graph& graph, float cellSize) : graph(graph), cellSize(cellSize) {
+}
+
+// The wall map has a texel for every corner, wall and cell interior: corners sit at even/even
+// coordinates, cell interiors at odd/odd, and the walls between them at the mixed positions.
+bool WallTexture::wallAt(int mapX, int mapY) const {
+    bool evenX = mapX % 2 == 0, evenY = mapY % 2 == 0;
+    if (evenX && evenY) {
+        return true;
+    }
+    if (evenX) {
+        return mapX == 0 || graph.hasWall(graph.getNode(mapX / 2 - 1, mapY / 2), WALL_RIGHT);
+    }
+    if (evenY) {
+        return mapY == 0 || graph.hasWall(graph.getNode(mapX / 2, mapY / 2 - 1), WALL_BOTTOM);
+    }
+    return false;
+}
+
+// Average of the wall-map texels under one texture texel, so far zoom shows wall density.
+Uint8 WallTexture::shade(unsigned texelX, unsigned texelY) const {
+    int mapWidth = graph.getColumns() * 2 + 1, mapHeight = graph.getRows() * 2 + 1;
+    int walls = 0, total = 0;
+    for (int y = texelY * factor; y < min(mapHeight, static_cast<int>(texelY + 1) * factor); ++y) {
+        for (int x = texelX * factor; x < min(mapWidth, static_cast<int>(texelX + 1) * factor); ++x) {
+            walls += wallAt(x, y);
+            ++total;
+        }
+    }
+    return static_cast<Uint8>(255 * walls / total);
+}
+
+void WallTexture::rebuild() {
+    unsigned mapWidth = graph.getColumns() * 2 + 1, mapHeight = graph.getRows() * 2 + 1;
+    unsigned maxSize = min(LOD_MAX_SIZE, Texture::getMaximumSize());
+    factor = static_cast<int>((max(mapWidth, mapHeight) + maxSize - 1) / maxSize);
+    width = (mapWidth + factor - 1) / factor;
+    height = (mapHeight + factor - 1) / factor;
+
+    pixels.resize(static_cast<size_t>(width) * height * 4);
+    for (unsigned y = 0; y < height; ++y) {
+        for (unsigned x = 0; x < width; ++x) {
+            Uint8* texel = &pixels[(static_cast<size_t>(y) * width + x) * 4];
+            texel[0] = texel[1] = texel[2] = shade(x, y);
+            texel[3] = 255;
+        }
+    }
+
+    if (texture.getSize() != Vector2u(width, height) && !texture.create(width, height)) {
+        cerr << "Failed to create the far-zoom maze texture" << endl;
+    }
+    texture.setSmooth(true);
+    texture.update(pixels.data());
+    sprite.setTexture(texture, true);
+
+    // A wall-map texel is half a cell, centred on the line it stands for.
+    float texelSize = factor * cellSize / 2;
+    sprite.setScale(texelSize, texelSize);
+    sprite.setPosition(-cellSize / 4, -cellSize / 4);
+
+    built = true;
+    syncedEpoch = graph.getEpoch();
+    syncedCarves = graph.getCarveLog().size();
+}
+
+void WallTexture::sync() {
+    if (!built || syncedEpoch != graph.getEpoch()) {
+        rebuild();
+        return;
+    }
+
+    const vector<uint32_t>& log = graph.getCarveLog();
+    if (log.size() == syncedCarves) {
+        return;
+    }
+
+    // As in WallMesh, a big backlog is cheaper as one upload than as single texels.
+    bool uploadAll = log.size() - syncedCarves > 4096;
+    for (size_t i = syncedCarves; i < log.size(); ++i) {
+        int cell = static_cast<int>(log[i] / 2);
+        bool bottom = log[i] % 2 != 0;
+        int mapX = graph.cellX(cell) * 2 + (bottom ? 1 : 2);
+        int mapY = graph.cellY(cell) * 2 + (bottom ? 2 : 1);
+        unsigned texelX = mapX / factor, texelY = mapY / factor;
+
+        Uint8* texel = &pixels[(static_cast<size_t>(texelY) * width + texelX) * 4];
+        texel[0] = texel[1] = texel[2] = shade(texelX, texelY);
+        if (!uploadAll) {
+            texture.update(texel, 1, 1, texelX, texelY);
+        }
+    }
+    if (uploadAll) {
+        texture.update(pixels.data());
+    }
+    syncedCarves = log.size();
+}
+
+void WallTexture::draw(RenderTarget& target, RenderStates states) const {
+    lastDraw = DrawCounts();
+    if (!built) {
+        return;
+    }
+    states.transform *= getTransform();
+    target.draw(sprite, states);
+    lastDraw.drawCalls = 1;
+    lastDraw.vertices = 4;
+}
+
+MazeCamera::MazeCamera(Vector2f windowSize, FloatRect mazeBounds) : windowSize(windowSize), bounds(mazeBounds) {
+    maxZoom = max(1.0f, max(bounds.width / windowSize.x, bounds.height / windowSize.y) * 1.1f);
+    view.setSize(windowSize);
+    follow(Vector2f(bounds.left, bounds.top));
+}
+
+void MazeCamera::zoomBy(float factor) {
+    zoom = min(maxZoom, max(MIN_ZOOM, zoom * factor));
+    view.setSize(windowSize.x * zoom, windowSize.y * zoom);
+}
+
+void MazeCamera::follow(Vector2f target) {
+    auto axis = [](float target, float start, float length, float viewLength) {
+        if (viewLength >= length) {
+            return start + length / 2;
+        }
+        return min(start + length - viewLength / 2, max(start + viewLength / 2, target));
+    };
+    view.setCenter(axis(target.x, bounds.left, bounds.width, view.getSize().x),
+        axis(target.y, bounds.top, bounds.height, view.getSize().y));
+}
+
+PathOverlay::PathOverlay(const Graph& graph, float cellSize) : graph(graph), cellSize(cellSize) {
+}
+
+void PathOverlay::setPath(const vector<int>& path) {
+    const Color HINT_COLOR(255, 215, 0, 160);
+    float inset = cellSize * 0.4f;
+
+    vertices.clear();
+    for (int cell : path) {
+        float left = graph.cellX(cell) * cellSize + inset, top = graph.cellY(cell) * cellSize + inset;
+        float right = left + cellSize - 2 * inset, bottom = top + cellSize - 2 * inset;
+        vertices.emplace_back(Vector2f(left, top), HINT_COLOR);
+        vertices.emplace_back(Vector2f(right, top), HINT_COLOR);
+        vertices.emplace_back(Vector2f(right, bottom), HINT_COLOR);
+        vertices.emplace_back(Vector2f(left, top), HINT_COLOR);
+        vertices.emplace_back(Vector2f(right, bottom), HINT_COLOR);
+        vertices.emplace_back(Vector2f(left, bottom), HINT_COLOR);
+    }
+}
+
+void PathOverlay::draw(RenderTarget& target, RenderStates states) const {
+    states.transform *= getTransform();
+    target.draw(vertices.data(), vertices.size(), Triangles, states);
+}
+
+SwarmOverlay::SwarmOverlay(const Graph& graph, float cellSize) : graph(graph), cellSize(cellSize) {
+}
+
+void SwarmOverlay::setAgents(const vector<uint32_t>& cells, const FloatRect& visible) {
+    if (counts.size() != static_cast<size_t>(graph.cellCount())) {
+        counts.assign(graph.cellCount(), 0);
+    }
+    occupied.clear();
+    for (uint32_t cell : cells) {
+        if (counts[cell]++ == 0) {
+            occupied.push_back(cell);
+        }
+    }
+
+    // The visible cells, clamped to the maze
+    FloatRect area = getInverseTransform().transformRect(visible);
+    int firstX = max(0, static_cast<int>(floor(area.left / cellSize)));
+    int firstY = max(0, static_cast<int>(floor(area.top / cellSize)));
+    int lastX = min(graph.getColumns() - 1, static_cast<int>(floor((area.left + area.width) / cellSize)));
+    int lastY = min(graph.getRows() - 1, static_cast<int>(floor((area.top + area.height) / cellSize)));
+    float inset = cellSize * 0.25f;
+
+    vertices.clear();
+    for (uint32_t cell : occupied) {
+        int x = graph.cellX(cell), y = graph.cellY(cell);
+        if (x >= firstX && x <= lastX && y >= firstY && y <= lastY) {
+            Color color(255, 80, 40, static_cast<Uint8>(min<uint32_t>(255, 96 + 16 * counts[cell])));
+            float left = x * cellSize + inset, top = y * cellSize + inset;
+            float right = left + cellSize - 2 * inset, bottom = top + cellSize - 2 * inset;
+            vertices.emplace_back(Vector2f(left, top), color);
+            vertices.emplace_back(Vector2f(right, top), color);
+            vertices.emplace_back(Vector2f(right, bottom), color);
+            vertices.emplace_back(Vector2f(left, top), color);
+            vertices.emplace_back(Vector2f(right, bottom), color);
+            vertices.emplace_back(Vector2f(left, bottom), color);
+        }
+        counts[cell] = 0;
+    }
+}
+
+void SwarmOverlay::draw(RenderTarget& target, RenderStates states) const {
+    states.transform *= getTransform();
+    target.draw(vertices.data(), vertices.size(), Triangles, states);
+}
+
+MazeRenderer::MazeRenderer(const Graph& graph) : graph(graph), exitTexture(&entranceTexture), visitedTexture(&entranceTexture) {
+    entranceSprite.setTexture(entranceTexture, true);
+    exitSprite.setTexture(*exitTexture, true);
+    visitedSprite.setTexture(*visitedTexture, true);
+}
+
+void MazeRenderer::setTextures(const Texture& exit, const Texture& visited) {
+    exitTexture = &exit;
+    visitedTexture = &visited;
+    exitSprite.setTexture(exit, true);
+    visitedSprite.setTexture(visited, true);
+}
+
+void MazeRenderer::fitToCell(Sprite& sprite, const Texture& texture, int cellSize) {
+    sprite.setScale(cellSize / static_cast<float>(texture.getSize().x),
+        cellSize / static_cast<float>(texture.getSize().y));
+}
+
+DrawCounts MazeRenderer::draw_maze(RenderTarget& target, const WallLayer& wallLayer, int cellSize, Vector2f offset, int current, bool generationCompleted) {
+    // Sprites are one quad each; the wall layer reports what its culling let through.
+    target.clear(Color::Black);
+    target.draw(wallLayer);
+    DrawCounts counts = wallLayer.getLastDraw();
+
+    entranceSprite.setPosition(offset);
+    fitToCell(entranceSprite, entranceTexture, cellSize);
+    target.draw(entranceSprite);
+
+    exitSprite.setPosition(offset.x + (graph.getColumns() - 1) * cellSize, offset.y + (graph.getRows() - 1) * cellSize);
+    fitToCell(exitSprite, *exitTexture, cellSize);
+    target.draw(exitSprite);
+    counts.drawCalls += 2;
+    counts.vertices += 8;
+
+    if (current >= 0 && !generationCompleted) {
+        visitedSprite.setPosition(offset.x + graph.cellX(current) * cellSize, offset.y + graph.cellY(current) * cellSize);
+        fitToCell(visitedSprite, *visitedTexture, cellSize);
+        target.draw(visitedSprite);
+        counts.drawCalls += 1;
+        counts.vertices += 4;
+    }
+    return counts;
+}
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include "MazeCore/Graph.h"
+
+#include <memory>
+#include <vector>
+
+// What a draw submitted, for the profiler overlay.
+struct DrawCounts {
+    size_t drawCalls = 0;
+    size_t vertices = 0;
+};
+
+// The static wall layer of a maze. Implementations keep themselves in step with the graph by
+// replaying its carve log in sync(), and only submit what intersects the target's view.
+class WallLayer : public sf::Drawable, public sf::Transformable {
+protected:
+    mutable DrawCounts lastDraw;
+
+public:
+    virtual void sync() = 0;
+
+    // What the most recent draw submitted.
+    const DrawCounts& getLastDraw() const { return lastDraw; }
+};
+
+// The walls as line lists in vertex buffers, one per TILE_SIZE x TILE_SIZE tile of cells.
+// Within a tile, local cell i owns vertices 4i..4i+3 (its right wall, then its bottom wall);
+// the outer top and left borders are four more vertices of their own. Tiles are only built
+// for the view and a tile around it, when a draw first needs them, and dropped once the view
+// moves on, so memory and build time follow the visible area, not the maze (WallTexture
+// covers far zoom). Carved walls are patched in place by making their vertices transparent,
+// replaying only the new entries of the graph's carve log into tiles that are built.
+// Drawing is culled to the rows and columns inside the view: one range per tile when whole
+// tile rows are visible, otherwise one range per visible row of each tile.
+class WallMesh : public WallLayer {
+private:
+    struct Tile {
+        int left, top, columns, rows;  // in cells
+        std::vector<sf::Vertex> vertices;
+        sf::VertexBuffer buffer;
+        bool dirty = false;            // vertices changed since the last upload
+    };
+
+    const Graph& graph;
+    float cellSize;
+    bool useBuffer;
+    bool built = false;
+    unsigned syncedEpoch = 0;
+    size_t syncedCarves = 0;
+    int tileColumns = 0, tileRows = 0;
+    sf::Vertex border[4];
+
+    // Built on demand while drawing, which is why they are mutable.
+    mutable std::vector<std::unique_ptr<Tile>> tiles;
+    mutable std::vector<int> builtTiles;
+
+    static void setLine(sf::Vertex* vertices, sf::Vector2f from, sf::Vector2f to, sf::Color color);
+    void rebuild();
+    std::unique_ptr<Tile> buildTile(int tileX, int tileY) const;
+    void drawRange(sf::RenderTarget& target, const sf::RenderStates& states, const Tile& tile, size_t first, size_t count) const;
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+public:
+    static const int TILE_SIZE = 64;
+
+    WallMesh(const Graph& graph, float cellSize);
+
+    // Brings the built tiles up to date with the graph. Only walls carved since the last call are touched.
+    void sync() override;
+
+    size_t builtTileCount() const { return builtTiles.size(); }
+};
+
+// Far-zoom level of detail: the maze as a texture with one texel per wall or cell interior
+// (a (2W+1) x (2H+1) map), box-filtered down until it fits LOD_MAX_SIZE. It is one sprite
+// whatever the maze size, for zoom levels where a cell is only a few pixels across and
+// individual lines would just alias. Carves patch single texels, like WallMesh.
+class WallTexture : public WallLayer {
+private:
+    const Graph& graph;
+    float cellSize;
+    int factor = 1;  // wall-map texels per texture texel, in each direction
+    unsigned width = 0, height = 0;
+    std::vector<sf::Uint8> pixels;
+    sf::Texture texture;
+    sf::Sprite sprite;
+    bool built = false;
+    unsigned syncedEpoch = 0;
+    size_t syncedCarves = 0;
+
+    bool wallAt(int mapX, int mapY) const;
+    sf::Uint8 shade(unsigned texelX, unsigned texelY) const;
+    void rebuild();
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+public:
+    static const unsigned LOD_MAX_SIZE = 2048;
+
+    WallTexture(const Graph& graph, float cellSize);
+
+    void sync() override;
+};
+
+// A view that follows the player around a maze and zooms. While the maze fits in the view along
+// an axis it stays centred on that axis; otherwise the view is clamped to the maze's edges.
+class MazeCamera {
+private:
+    sf::View view;
+    sf::Vector2f windowSize;
+    sf::FloatRect bounds;
+    float zoom = 1.0f;
+    float maxZoom;
+
+public:
+    static constexpr float MIN_ZOOM = 0.25f;
+
+    MazeCamera(sf::Vector2f windowSize, sf::FloatRect mazeBounds);
+
+    // factor > 1 zooms out. Zoom is clamped between MIN_ZOOM and seeing the whole maze.
+    void zoomBy(float factor);
+    void follow(sf::Vector2f target);
+
+    const sf::View& getView() const { return view; }
+
+    // Screen pixels per world unit (a world unit is a pixel at zoom 1).
+    float getScale() const { return 1.0f / zoom; }
+};
+
+// A dot in the middle of every cell of a path (the hint overlay), drawn as one triangle batch.
+// The vertex array keeps its capacity, so only a path longer than any before allocates.
+class PathOverlay : public sf::Drawable, public sf::Transformable {
+private:
+    const Graph& graph;
+    float cellSize;
+    std::vector<sf::Vertex> vertices;
+
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+public:
+    PathOverlay(const Graph& graph, float cellSize);
+
+    void setPath(const std::vector<int>& path);
+    void clear() { vertices.clear(); }
+    size_t vertexCount() const { return vertices.size(); }
+};
+
+// The rival explorers (see MazeCore/AgentSwarm.h) as one triangle batch with a quad per
+// occupied cell rather than per agent, more opaque the more agents share it. Only cells
+// inside the visible rectangle are built, and the arrays keep their capacity between frames.
+class SwarmOverlay : public sf::Drawable, public sf::Transformable {
+private:
+    const Graph& graph;
+    float cellSize;
+    std::vector<uint32_t> counts;     // agents per cell, zero again once the batch is built
+    std::vector<uint32_t> occupied;
+    std::vector<sf::Vertex> vertices;
+
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+public:
+    SwarmOverlay(const Graph& graph, float cellSize);
+
+    // cells holds each agent's cell; visible is in the target's coordinates.
+    void setAgents(const std::vector<uint32_t>& cells, const sf::FloatRect& visible);
+    void clear() { vertices.clear(); }
+    size_t vertexCount() const { return vertices.size(); }
+};
+
+// Draws a Graph with SFML: the wall layer plus the entrance, treasure and carving-cursor sprites.
+class MazeRenderer {
+private:
+    const Graph& graph;
+    sf::Texture entranceTexture;
+    const sf::Texture* exitTexture;     // blank (the entrance texture) until setTextures()
+    const sf::Texture* visitedTexture;
+    sf::Sprite entranceSprite, exitSprite, visitedSprite;
+
+    static void fitToCell(sf::Sprite& sprite, const sf::Texture& texture, int cellSize);
+
+public:
+    explicit MazeRenderer(const Graph& graph);
+
+    // The treasure and carving-cursor images, once they are loaded (see AssetManager.h).
+    // The textures are not copied and must outlive the renderer.
+    void setTextures(const sf::Texture& exit, const sf::Texture& visited);
+
+    DrawCounts draw_maze(sf::RenderTarget& target, const WallLayer& wallLayer, int cellSize, sf::Vector2f offset, int current = -1, bool generationCompleted = false);
+};
@@ -0,0 +1,51 @@
+#include "ProfilerOverlay.h"
+
+#include <cstdio>
+
+using namespace sf;
+using namespace std;
+
+ProfilerOverlay::ProfilerOverlay(const Font& font) {
+    text.setFont(font);
+    text.setCharacterSize(22);
+    text.setFillColor(Color::Green);
+    text.setPosition(1500, 20);
+    background.setFillColor(Color(0, 0, 0, 200));
+    background.setPosition(1490, 10);
+    buffer.reserve(1024);
+}
+
+void ProfilerOverlay::update(const Profiler& profiler, float ticksPerSecond) {
+    if (framesUntilRefresh-- > 0) {
+        return;
+    }
+    framesUntilRefresh = REFRESH_FRAMES;
+
+    char line[96];
+    buffer = "phase       min    avg    p99  ms\n";
+    for (int phase = 0; phase <= profiler.phaseCount(); ++phase) {
+        Profiler::PhaseStats stats = profiler.stats(phase);
+        const char* name = phase < profiler.phaseCount() ? profiler.phaseName(phase).c_str() : "frame";
+        snprintf(line, sizeof(line), "%-9s %6.2f %6.2f %6.2f\n", name, stats.minMs, stats.avgMs, stats.p99Ms);
+        buffer += line;
+    }
+    // Read-to-present time of the last moves; stays at zero until the player moves.
+    Profiler::PhaseStats latency = profiler.inputLatency();
+    snprintf(line, sizeof(line), "%-9s %6.2f %6.2f %6.2f\n", "input", latency.minMs, latency.avgMs, latency.p99Ms);
+    buffer += line;
+    if (ticksPerSecond > 0) {
+        snprintf(line, sizeof(line), "simulation %.0f ticks/s\n", ticksPerSecond);
+        buffer += line;
+    }
+    snprintf(line, sizeof(line), "draws %zu   vertices %zu", profiler.getDrawCalls(), profiler.getVertices());
+    buffer += line;
+
+    text.setString(buffer);
+    FloatRect bounds = text.getLocalBounds();
+    background.setSize(Vector2f(bounds.width + 20, bounds.height + 30));
+}
+
+void ProfilerOverlay::draw(RenderTarget& target, RenderStates states) const {
+    target.draw(background, states);
+    target.draw(text, states);
+}
@@ -0,0 +1,27 @@
+#pragma once
+
+#include <SFML/Graphics.hpp>
+
+#include "MazeCore/Profiler.h"
+
+#include <string>
+
+// F3 overlay: rolling min/avg/p99 per frame phase plus last frame's draw calls and vertices.
+// The text is only rebuilt every REFRESH_FRAMES frames so the numbers stay readable.
+class ProfilerOverlay : public sf::Drawable {
+private:
+    sf::RectangleShape background;
+    sf::Text text;
+    std::string buffer;
+    int framesUntilRefresh = 0;
+
+    void draw(sf::RenderTarget& target, sf::RenderStates states) const override;
+
+public:
+    static const int REFRESH_FRAMES = 30;
+
+    explicit ProfilerOverlay(const sf::Font& font);
+
+    // ticksPerSecond, when given, is the simulation rate of a thread that does not draw.
+    void update(const Profiler& profiler, float ticksPerSecond = 0);
+};
@@ -0,0 +1,63 @@
+// assetpack: packs the game's assets into one file for shipping.
+//
+//   assetpack OUT DIR...
+//
+// Every file under each DIR goes into the pack (see MazeCore/AssetPack.h), named by its path
+// relative to the working directory with forward slashes, which is how the game asks for it.
+// Run from the folder holding Font, Graphics and Sound:  assetpack assets.mqas Font Graphics Sound
+#include "../MazeCore/AssetPack.h"
+
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <iostream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+int main(int argc, char* argv[]) {
+    if (argc < 3) {
+        cerr << "usage: assetpack OUT DIR..." << endl;
+        return 1;
+    }
+
+    vector<string> names;
+    for (int i = 2; i < argc; ++i) {
+        error_code error;
+        for (filesystem::recursive_directory_iterator it(argv[i], error), end; !error && it != end; it.increment(error)) {
+            if (it->is_regular_file()) {
+                names.push_back(it->path().generic_string());
+            }
+        }
+        if (error) {
+            cerr << "Failed to read " << argv[i] << ": " << error.message() << endl;
+            return 1;
+        }
+    }
+    // Sorted, so the same files always make the same pack.
+    sort(names.begin(), names.end());
+
+    vector<string> contents;
+    size_t total = 0;
+    for (const string& name : names) {
+        ifstream file(name, ios::binary);
+        contents.emplace_back(istreambuf_iterator<char>(file), istreambuf_iterator<char>());
+        if (!file) {
+            cerr << "Failed to read " << name << endl;
+            return 1;
+        }
+        total += contents.back().size();
+    }
+
+    string pack;
+    appendAssetPack(pack, names, contents);
+    ofstream out(argv[1], ios::binary | ios::trunc);
+    if (!out.write(pack.data(), pack.size())) {
+        cerr << "Failed to write " << argv[1] << endl;
+        return 1;
+    }
+    cout << "Packed " << names.size() << " assets (" << total / 1024 << " KB) into " << argv[1] << endl;
+    return 0;
+}
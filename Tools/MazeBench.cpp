@@ -0,0 +1,429 @@
+// maze_bench: microbenchmarks for the maze core (and the renderer when built with SFML).
+//
+//   maze_bench [--sizes 64,512,2048] [--threads 1,2,4] [--min-time SECONDS] [--filter TEXT] [--out FILE|-]
+//
+// Every case is run in batches until --min-time has passed, and the fastest batch is reported
+// alongside the mean, so a noisy neighbour on the host inflates the mean but rarely the best.
+// Results are written as one JSON document (to stdout unless --out is given) for tracking
+// regressions between releases; progress goes to stderr.
+#include "../MazeCore/AgentSwarm.h"
+#include "../MazeCore/Graph.h"
+#include "../MazeCore/MazeFile.h"
+#include "../MazeCore/MazeGenerator.h"
+#include "../MazeCore/Rng.h"
+#include "../MazeCore/Solver.h"
+#include "../MazeCore/TiledGenerator.h"
+#include "../MazeCore/WallPlanes.h"
+
+#ifdef MAZE_BENCH_SFML
+#include "../MazeRenderer.h"
+#endif
+
+#include <algorithm>
+#include <chrono>
+#include <cstdint>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <memory>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+struct Options {
+    vector<int> sizes = { 64, 512, 2048 };
+    vector<int> threads;  // thread counts for generate_tiled; 1, 2, 4, ... up to every core if empty
+    double minTime = 0.5;
+    string filter;
+    string outPath = "-";
+};
+
+// One line of the report. ops is what a single run of the case does (cells generated,
+// lookups made, ...), so nsPerOp is comparable across sizes.
+struct Result {
+    string name;
+    string algorithm;
+    int size = 0;
+    double opsPerRun = 0;
+    long long runs = 0;
+    double bestNsPerOp = 0;
+    double meanNsPerOp = 0;
+    int threads = 0;
+    double speedup = 0;  // against the same case on one thread
+    string note;
+};
+
+static void printUsage() {
+    cerr << "usage: maze_bench [--sizes 64,512,2048] [--threads 1,2,4] [--min-time SECONDS] [--filter TEXT] [--out FILE|-]" << endl;
+}
+
+static vector<int> parseList(const string& value) {
+    vector<int> list;
+    stringstream items(value);
+    string item;
+    while (getline(items, item, ',')) {
+        list.push_back(stoi(item));
+    }
+    return list;
+}
+
+static bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (i + 1 >= argc) {
+            cerr << "missing value for " << arg << endl;
+            return false;
+        }
+        string value = argv[++i];
+
+        if (arg == "--sizes") options.sizes = parseList(value);
+        else if (arg == "--threads") options.threads = parseList(value);
+        else if (arg == "--min-time") options.minTime = stod(value);
+        else if (arg == "--filter") options.filter = value;
+        else if (arg == "--out") options.outPath = value;
+        else {
+            cerr << "unknown option " << arg << endl;
+            return false;
+        }
+    }
+
+    if (options.sizes.empty() || *min_element(options.sizes.begin(), options.sizes.end()) < 2 || options.minTime <= 0) {
+        cerr << "sizes must be at least 2 and min-time positive" << endl;
+        return false;
+    }
+    if (options.threads.empty()) {
+        int cores = max(1, static_cast<int>(thread::hardware_concurrency()));
+        for (int threads = 1; threads < cores; threads *= 2) {
+            options.threads.push_back(threads);
+        }
+        options.threads.push_back(cores);
+    }
+    // Ascending, so the one-thread run a speedup is taken against comes first
+    sort(options.threads.begin(), options.threads.end());
+    options.threads.erase(unique(options.threads.begin(), options.threads.end()), options.threads.end());
+    if (options.threads.front() < 1) {
+        cerr << "threads must be at least 1" << endl;
+        return false;
+    }
+    return true;
+}
+
+class Bench {
+private:
+    const Options& options;
+    vector<Result> results;
+
+public:
+    explicit Bench(const Options& options) : options(options) {}
+
+    bool wanted(const string& name, const string& algorithm) const {
+        return options.filter.empty() || (name + "/" + algorithm).find(options.filter) != string::npos;
+    }
+
+    const vector<int>& threadCounts() const { return options.threads; }
+
+    // Times run() (which does opsPerRun operations) in batches, each at least a tenth of the
+    // minimum time, after one untimed warm-up run. setup() runs before every run, untimed.
+    // Returns the result, valid until the next case, or null if the filter skips it.
+    Result* measure(const string& name, const string& algorithm, int size, double opsPerRun,
+        const function<void()>& setup, const function<void()>& run) {
+        if (!wanted(name, algorithm)) {
+            return nullptr;
+        }
+        using clock = chrono::steady_clock;
+
+        setup();
+        run();
+
+        Result result;
+        result.name = name;
+        result.algorithm = algorithm;
+        result.size = size;
+        result.opsPerRun = opsPerRun;
+        result.bestNsPerOp = 1e300;
+
+        double total = 0;
+        double batchTarget = options.minTime / 10;
+        while (total < options.minTime) {
+            double batch = 0;
+            long long batchRuns = 0;
+            while (batch < batchTarget) {
+                setup();
+                auto start = clock::now();
+                run();
+                batch += chrono::duration<double>(clock::now() - start).count();
+                ++batchRuns;
+            }
+            result.bestNsPerOp = min(result.bestNsPerOp, batch * 1e9 / (batchRuns * opsPerRun));
+            result.runs += batchRuns;
+            total += batch;
+        }
+        result.meanNsPerOp = total * 1e9 / (result.runs * opsPerRun);
+
+        cerr << name << (algorithm.empty() ? "" : " ") << algorithm << " " << size << ": " << result.bestNsPerOp << " ns/op" << endl;
+        results.push_back(result);
+        return &results.back();
+    }
+
+    void skip(const string& name, const string& note) {
+        if (!wanted(name, "")) {
+            return;
+        }
+        Result result;
+        result.name = name;
+        result.note = note;
+        cerr << name << ": skipped (" << note << ")" << endl;
+        results.push_back(result);
+    }
+
+    void writeJson(ostream& out) const {
+        out << "{\n  \"schema\": 1,\n";
+#if defined(__clang__)
+        out << "  \"compiler\": \"clang " << __clang_major__ << "." << __clang_minor__ << "\",\n";
+#elif defined(__GNUC__)
+        out << "  \"compiler\": \"gcc " << __GNUC__ << "." << __GNUC_MINOR__ << "\",\n";
+#elif defined(_MSC_VER)
+        out << "  \"compiler\": \"msvc " << _MSC_VER << "\",\n";
+#endif
+#ifdef NDEBUG
+        out << "  \"optimized\": true,\n";
+#else
+        out << "  \"optimized\": false,\n";
+#endif
+        out << "  \"hardware_threads\": " << thread::hardware_concurrency() << ",\n";
+        out << "  \"results\": [";
+        for (size_t i = 0; i < results.size(); ++i) {
+            const Result& r = results[i];
+            out << (i ? ",\n" : "\n") << "    { \"name\": \"" << r.name << "\"";
+            if (!r.algorithm.empty()) out << ", \"algorithm\": \"" << r.algorithm << "\"";
+            if (r.size) out << ", \"size\": " << r.size;
+            if (r.runs) {
+                out << ", \"ops_per_run\": " << static_cast<long long>(r.opsPerRun) << ", \"runs\": " << r.runs
+                    << ", \"best_ns_per_op\": " << r.bestNsPerOp << ", \"mean_ns_per_op\": " << r.meanNsPerOp;
+            }
+            if (r.threads) out << ", \"threads\": " << r.threads;
+            if (r.speedup > 0) out << ", \"speedup\": " << r.speedup;
+            if (!r.note.empty()) out << ", \"skipped\": \"" << r.note << "\"";
+            out << " }";
+        }
+        out << "\n  ]\n}\n";
+    }
+};
+
+static void generateFully(MazeGenerator& generator) {
+    while (generator.step()) {
+    }
+}
+
+static void benchGeneration(Bench& bench, int size) {
+    Graph graph(size, size);
+    for (int i = 0; i < ALGORITHM_COUNT; ++i) {
+        Algorithm algorithm = static_cast<Algorithm>(i);
+        if (!bench.wanted("generate", algorithmName(algorithm))) {
+            continue;
+        }
+        unique_ptr<MazeGenerator> generator = makeGenerator(algorithm, graph, 0);
+        uint64_t seed = 0;
+        bench.measure("generate", algorithmName(algorithm), size, graph.cellCount(),
+            [&] { generator->reset(deriveSeed(1, seed++)); },
+            [&] { generateFully(*generator); });
+    }
+
+    // The same in DEFAULT_TILE_SIZE tiles, on each thread count, with the speedup over one thread
+    for (int i = 0; i < ALGORITHM_COUNT; ++i) {
+        Algorithm algorithm = static_cast<Algorithm>(i);
+        if (!bench.wanted("generate_tiled", algorithmName(algorithm))) {
+            continue;
+        }
+        double oneThreadNsPerOp = 0;
+        for (int threads : bench.threadCounts()) {
+            uint64_t seed = 0;
+            Result* result = bench.measure("generate_tiled", algorithmName(algorithm), size, graph.cellCount(), [] {},
+                [&] { generateTiled(graph, algorithm, deriveSeed(1, seed++), threads); });
+            result->threads = threads;
+            if (threads == 1) {
+                oneThreadNsPerOp = result->bestNsPerOp;
+            }
+            if (oneThreadNsPerOp > 0) {
+                result->speedup = oneThreadNsPerOp / result->bestNsPerOp;
+                cerr << "  on " << threads << (threads == 1 ? " thread" : " threads") << ", " << result->speedup << "x one thread" << endl;
+            }
+        }
+    }
+}
+
+// Keeps the compiler from dropping lookups whose results are otherwise unused.
+static volatile uint64_t lookupSink;
+
+static void benchLookups(Bench& bench, int size) {
+    if (!bench.wanted("lookup", "")) {
+        return;
+    }
+    Graph graph(size, size);
+    unique_ptr<MazeGenerator> generator = makeGenerator(Algorithm::Kruskal, graph, 1);
+    generateFully(*generator);
+
+    // Coordinates are drawn up front so the timed loop is only getNode plus the wall read.
+    const int LOOKUPS = 1 << 16;
+    vector<uint32_t> coordinates(LOOKUPS * 2);
+    Rng rng(2);
+    for (uint32_t& c : coordinates) {
+        c = rng.bounded(size);
+    }
+    bench.measure("lookup", "", size, LOOKUPS, [] {}, [&] {
+        uint64_t walls = 0;
+        for (int i = 0; i < LOOKUPS; ++i) {
+            int cell = graph.getNode(coordinates[2 * i], coordinates[2 * i + 1]);
+            walls += graph.hasWall(cell, WALL_RIGHT) + graph.getWalls(cell);
+        }
+        lookupSink = walls;
+    });
+}
+
+static void benchSolver(Bench& bench, int size) {
+    Graph graph(size, size);
+    unique_ptr<MazeGenerator> generator = makeGenerator(Algorithm::Kruskal, graph, 3);
+    generateFully(*generator);
+    Solver solver(graph);
+    vector<int> path;
+    int entrance = graph.getNode(0, 0), exit = graph.getNode(size - 1, size - 1);
+
+    bench.measure("solve_distance_field", "", size, graph.cellCount(), [] {}, [&] { solver.computeDistances(exit); });
+
+    // The bit-plane flood fill answers "is every cell reachable" for a fraction of a BFS
+    WallPlanes planes;
+    bench.measure("validate", "", size, graph.cellCount(), [] {}, [&] { validateMaze(graph, planes); });
+
+    solver.computeDistances(exit);
+    bench.measure("solve_hint_walk", "", size, solver.distanceTo(entrance) + 1, [] {}, [&] { solver.pathToSource(entrance, path); });
+    bench.measure("solve_astar", "", size, 1, [] {}, [&] { solver.findPath(entrance, exit, path); });
+}
+
+// The first second of a race: 100k rivals (the game's most) stepped 60 times from the
+// entrance, on every hardware thread. Reported per agent step; a 60 Hz tick is 100k of them.
+static void benchAgents(Bench& bench, int size) {
+    if (!bench.wanted("swarm_step", "")) {
+        return;
+    }
+    const size_t AGENTS = 100000;
+    const int STEPS = 60;
+    Graph graph(size, size);
+    unique_ptr<MazeGenerator> generator = makeGenerator(Algorithm::Prim, graph, 9);
+    generateFully(*generator);
+    AgentSwarm swarm(graph);
+    int entrance = graph.getNode(0, 0), exit = graph.getNode(size - 1, size - 1);
+
+    bench.measure("swarm_step", "", size, static_cast<double>(AGENTS) * STEPS,
+        [&] { swarm.reset(AGENTS, entrance, exit, 9); },
+        [&] {
+            for (int i = 0; i < STEPS; ++i) {
+                swarm.step();
+            }
+        });
+}
+
+// Saving to and loading from the binary maze format, in memory so the disk is left out. Loading
+// carves through the same Graph calls as generation, so it compares directly with "generate".
+static void benchFiles(Bench& bench, int size) {
+    if (!bench.wanted("save", "") && !bench.wanted("load", "")) {
+        return;
+    }
+    Graph graph(size, size);
+    unique_ptr<MazeGenerator> generator = makeGenerator(Algorithm::Kruskal, graph, 5);
+    generateFully(*generator);
+    MazeInfo info;
+    info.seed = generator->getSeed();
+    info.algorithm = generator->getAlgorithm();
+    string file;
+
+    bench.measure("save", "", size, graph.cellCount(), [&] { file.clear(); }, [&] { appendMazeFile(file, graph, info); });
+
+    file.clear();
+    appendMazeFile(file, graph, info);
+    Graph loaded(size, size);
+    const uint8_t* data = reinterpret_cast<const uint8_t*>(file.data());
+    bench.measure("load", "", size, graph.cellCount(), [] {}, [&] { loadMaze(data, file.size(), loaded); });
+}
+
+#ifdef MAZE_BENCH_SFML
+// Offscreen 1080p frames: the same draw_maze call the game makes, into a RenderTexture. "draw_maze"
+// is the game's 1:1 view in the middle of the maze (culled wall lines); "draw_maze_lod" has the
+// whole maze in view (far-zoom texture). The GPU queue is drained once after each run so its work
+// is counted without a readback per frame.
+static void benchDraw(Bench& bench, int size) {
+    if (!bench.wanted("draw_maze", "")) {
+        return;
+    }
+    const int CELL_SIZE = 40;
+    const int FRAMES = 16;
+    sf::RenderTexture target;
+    if (!target.create(1920, 1080)) {
+        bench.skip("draw_maze", "cannot create a render texture");
+        return;
+    }
+
+    Graph graph(size, size);
+    graph.setCarveLogging(true);
+    unique_ptr<MazeGenerator> generator = makeGenerator(Algorithm::Prim, graph, 4);
+    generateFully(*generator);
+    WallMesh wallMesh(graph, CELL_SIZE);
+    WallTexture wallTexture(graph, CELL_SIZE);
+    MazeRenderer renderer(graph);
+    float extent = static_cast<float>(size * CELL_SIZE);
+    MazeCamera camera(sf::Vector2f(1920, 1080), sf::FloatRect(0, 0, extent, extent));
+
+    auto frames = [&](WallLayer& walls) {
+        for (int i = 0; i < FRAMES; ++i) {
+            walls.sync();
+            target.setView(camera.getView());
+            renderer.draw_maze(target, walls, CELL_SIZE, sf::Vector2f(0, 0), -1, true);
+            target.display();
+        }
+        target.getTexture().copyToImage();
+    };
+
+    camera.follow(sf::Vector2f(extent / 2, extent / 2));
+    bench.measure("draw_maze", "", size, FRAMES, [] {}, [&] { frames(wallMesh); });
+    camera.zoomBy(1e9f);
+    camera.follow(sf::Vector2f(extent / 2, extent / 2));
+    bench.measure("draw_maze_lod", "", size, FRAMES, [] {}, [&] { frames(wallTexture); });
+}
+#endif
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+
+    Bench bench(options);
+    for (int size : options.sizes) {
+        benchGeneration(bench, size);
+        benchLookups(bench, size);
+        benchSolver(bench, size);
+        benchFiles(bench, size);
+        benchAgents(bench, size);
+#ifdef MAZE_BENCH_SFML
+        benchDraw(bench, size);
+#endif
+    }
+#ifndef MAZE_BENCH_SFML
+    bench.skip("draw_maze", "built without SFML");
+#endif
+
+    if (options.outPath == "-") {
+        bench.writeJson(cout);
+        return 0;
+    }
+    ofstream file(options.outPath);
+    if (!file) {
+        cerr << "cannot open " << options.outPath << " for writing" << endl;
+        return 1;
+    }
+    bench.writeJson(file);
+    return 0;
+}
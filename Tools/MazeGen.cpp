@@ -0,0 +1,247 @@
+// mazegen: batch maze generation without a display.
+//
+//   mazegen [--count N] [--width W] [--height H] [--algo NAME] [--seed S]
+//           [--threads T] [--tiles SIZE] [--format text|maze|pack] [--out FILE|-]
+//
+// Every worker thread owns its own Graph and generator (and so its own RNG stream).
+// Maze i is always built from deriveSeed(S, i), so a batch is reproducible whatever the
+// thread count. Mazes are written in index order, as plain text by default, as a binary
+// maze file (one maze only) or as a level pack (see MazeCore/MazeFile.h); without --out
+// they are only generated, which is handy for measuring throughput. Every maze is checked to
+// be perfect (see MazeCore/WallPlanes.h); any that is not makes the run fail.
+//
+// With --tiles, mazes are built one at a time instead, each cut into SIZE x SIZE tiles that
+// all the threads generate together (see MazeCore/TiledGenerator.h). That is the way to
+// build one very large maze quickly.
+#include "../MazeCore/Graph.h"
+#include "../MazeCore/MazeFile.h"
+#include "../MazeCore/MazeText.h"
+#include "../MazeCore/MazeGenerator.h"
+#include "../MazeCore/Rng.h"
+#include "../MazeCore/Solver.h"
+#include "../MazeCore/TiledGenerator.h"
+#include "../MazeCore/WallPlanes.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <fstream>
+#include <memory>
+#include <iostream>
+#include <mutex>
+#include <random>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+struct Options {
+    int count = 1;
+    int width = 20;
+    int height = 10;
+    Algorithm algorithm = Algorithm::Prim;
+    uint64_t seed = 0;
+    bool seedGiven = false;
+    int threads = 0;
+    int tileSize = 0;
+    string format = "text";
+    string outPath;
+};
+
+static void printUsage() {
+    cerr << "usage: mazegen [--count N] [--width W] [--height H] [--algo NAME] [--seed S]\n"
+            "               [--threads T] [--tiles SIZE] [--format text|maze|pack] [--out FILE|-]\n"
+            "algorithms:";
+    for (int i = 0; i < ALGORITHM_COUNT; ++i) {
+        cerr << " " << algorithmName(static_cast<Algorithm>(i));
+    }
+    cerr << endl;
+}
+
+static bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (i + 1 >= argc) {
+            cerr << "missing value for " << arg << endl;
+            return false;
+        }
+        string value = argv[++i];
+
+        if (arg == "--count") options.count = stoi(value);
+        else if (arg == "--width") options.width = stoi(value);
+        else if (arg == "--height") options.height = stoi(value);
+        else if (arg == "--algo") {
+            if (!parseAlgorithm(value, options.algorithm)) {
+                cerr << "unknown algorithm '" << value << "'" << endl;
+                return false;
+            }
+        }
+        else if (arg == "--seed") { options.seed = stoull(value, nullptr, 0); options.seedGiven = true; }
+        else if (arg == "--threads") options.threads = stoi(value);
+        else if (arg == "--tiles") options.tileSize = stoi(value);
+        else if (arg == "--format") options.format = value;
+        else if (arg == "--out") options.outPath = value;
+        else {
+            cerr << "unknown option " << arg << endl;
+            return false;
+        }
+    }
+
+    if (options.count < 1 || options.width < 1 || options.height < 1 || options.tileSize < 0) {
+        cerr << "count, width, height and tile size must be positive" << endl;
+        return false;
+    }
+    if (options.format != "text" && options.format != "maze" && options.format != "pack") {
+        cerr << "unknown format '" << options.format << "'" << endl;
+        return false;
+    }
+    if (options.format != "text" && (options.outPath.empty() || options.outPath == "-")) {
+        cerr << "--format " << options.format << " needs an --out file" << endl;
+        return false;
+    }
+    if (options.format == "maze" && options.count != 1) {
+        cerr << "a maze file holds one maze; use --format pack for more" << endl;
+        return false;
+    }
+    return true;
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+    if (!options.seedGiven) {
+        options.seed = (static_cast<uint64_t>(random_device{}()) << 32) ^ random_device{}();
+    }
+
+    int threadCount = options.threads > 0 ? options.threads : static_cast<int>(thread::hardware_concurrency());
+    threadCount = max(1, threadCount);
+    // Tiled mazes bring their own threads, so they are built one after another
+    int tileThreads = options.tileSize > 0 ? threadCount : 1;
+    int workerCount = options.tileSize > 0 ? 1 : min(threadCount, options.count);
+
+    bool binary = options.format != "text";
+    ofstream file;
+    ostream* out = nullptr;
+    MazePackWriter pack;
+    if (options.format == "pack") {
+        if (!pack.open(options.outPath, static_cast<uint32_t>(options.count))) {
+            cerr << "cannot open " << options.outPath << " for writing" << endl;
+            return 1;
+        }
+    }
+    else if (options.outPath == "-") {
+        out = &cout;
+    }
+    else if (!options.outPath.empty()) {
+        file.open(options.outPath, ios::binary);
+        if (!file) {
+            cerr << "cannot open " << options.outPath << " for writing" << endl;
+            return 1;
+        }
+        out = &file;
+    }
+    ostream& report = out == &cout ? cerr : cout;
+    bool writing = out || binary;
+
+    // Workers pull maze indices from a shared counter and hand their text to the writer in
+    // index order, so at most one maze per worker is buffered at a time.
+    atomic<int> nextMaze{ 0 };
+    int nextToWrite = 0;
+    mutex writeMutex;
+    condition_variable writeTurn;
+    atomic<size_t> peakWorkingMemory{ 0 };
+    atomic<int> imperfect{ 0 };
+
+    auto worker = [&]() {
+        Graph graph(options.width, options.height);
+        unique_ptr<MazeGenerator> generator;
+        if (options.tileSize == 0) {
+            generator = makeGenerator(options.algorithm, graph, 0);
+        }
+        WallPlanes planes;
+        unique_ptr<Solver> solver;
+        if (binary) {
+            solver.reset(new Solver(graph));
+        }
+        string text;
+
+        for (int index = nextMaze++; index < options.count; index = nextMaze++) {
+            uint64_t seed = deriveSeed(options.seed, index);
+            size_t memory = 0;
+            if (generator) {
+                generator->reset(seed);
+                while (generator->step()) {
+                }
+                memory = generator->workingMemoryBytes();
+            }
+            else {
+                memory = generateTiled(graph, options.algorithm, seed, tileThreads, options.tileSize);
+            }
+            size_t peak = peakWorkingMemory;
+            while (memory > peak && !peakWorkingMemory.compare_exchange_weak(peak, memory)) {
+            }
+            if (!validateMaze(graph, planes).perfect) {
+                cerr << "maze " << index << " (seed " << seed << ") is not a perfect maze" << endl;
+                ++imperfect;
+            }
+
+            if (!writing) {
+                continue;
+            }
+            if (binary) {
+                // Binary files record the solution length, so readers need not solve the maze.
+                MazeInfo info;
+                info.seed = seed;
+                info.algorithm = options.algorithm;
+                solver->computeDistances(graph.getNode(options.width - 1, options.height - 1));
+                info.solutionLength = solver->distanceTo(graph.getNode(0, 0));
+                text.clear();
+                appendMazeFile(text, graph, info);
+            }
+            else {
+                text = "# maze " + to_string(index) + " seed " + to_string(seed) + " " + algorithmName(options.algorithm) + " "
+                    + to_string(options.width) + "x" + to_string(options.height) + "\n";
+                appendMazeText(text, graph);
+            }
+
+            unique_lock<mutex> lock(writeMutex);
+            writeTurn.wait(lock, [&] { return nextToWrite == index; });
+            if (options.format == "pack") {
+                pack.add(text);
+            }
+            else {
+                out->write(text.data(), text.size());
+            }
+            ++nextToWrite;
+            writeTurn.notify_all();
+        }
+    };
+
+    auto start = chrono::steady_clock::now();
+    vector<thread> workers;
+    for (int i = 0; i < workerCount; ++i) {
+        workers.emplace_back(worker);
+    }
+    for (thread& t : workers) {
+        t.join();
+    }
+    if (options.format == "pack" && !pack.close()) {
+        cerr << "failed to write " << options.outPath << endl;
+        return 1;
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    double cells = static_cast<double>(options.width) * options.height * options.count;
+    report << "generated " << options.count << " " << algorithmName(options.algorithm) << " mazes of "
+        << options.width << "x" << options.height << " (seed " << options.seed << ") on "
+        << workerCount * tileThreads << " threads in " << seconds << " s: "
+        << options.count / seconds << " mazes/s, " << cells / seconds << " cells/s, peak generator memory "
+        << peakWorkingMemory << " bytes on top of the grid" << endl;
+    return imperfect > 0 ? 1 : 0;
+}
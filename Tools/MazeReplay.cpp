@@ -0,0 +1,94 @@
+// mazereplay: replays recorded rounds headlessly and checks they come out as recorded.
+//
+//   mazereplay [--verbose] FILE...
+//
+// Each replay's maze is rebuilt (from its seed, or from the maze file it carries) and its
+// moves are fed to a GameSession on their recorded ticks with no clock in the way, so a
+// round of minutes replays in microseconds. A replay whose outcome or length differs from the
+// recording means the simulation is no longer deterministic for it. Exits 1 if any differ.
+#include "../MazeCore/GameSession.h"
+#include "../MazeCore/Graph.h"
+#include "../MazeCore/MappedFile.h"
+#include "../MazeCore/MazeGenerator.h"
+#include "../MazeCore/Replay.h"
+
+#include <chrono>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+using namespace std;
+
+static const char* stateName(SessionState state) {
+    switch (state) {
+    case SessionState::Waiting: return "waiting";
+    case SessionState::Playing: return "abandoned";
+    case SessionState::Won: return "won";
+    case SessionState::OutOfMoves: return "out of moves";
+    case SessionState::OutOfTime: return "out of time";
+    }
+    return "?";
+}
+
+int main(int argc, char* argv[]) {
+    bool verbose = false;
+    vector<string> paths;
+    for (int i = 1; i < argc; ++i) {
+        if (string(argv[i]) == "--verbose") verbose = true;
+        else paths.push_back(argv[i]);
+    }
+    if (paths.empty()) {
+        cerr << "usage: mazereplay [--verbose] FILE..." << endl;
+        return 1;
+    }
+
+    // Replays of one size share a graph and, with the same algorithm, a generator.
+    unique_ptr<Graph> graph;
+    unique_ptr<MazeGenerator> generator;
+    unique_ptr<GameSession> session;
+    Replay replay;
+    MappedFile file;
+    int failed = 0;
+    int64_t ticks = 0;
+
+    auto started = chrono::steady_clock::now();
+    for (const string& path : paths) {
+        if (!file.open(path) || !readReplay(file.data(), file.size(), replay)) {
+            cerr << path << ": not a replay" << endl;
+            ++failed;
+            continue;
+        }
+        if (!graph || graph->getColumns() != replay.width || graph->getRows() != replay.height) {
+            session.reset();
+            generator.reset();
+            graph.reset(new Graph(replay.width, replay.height));
+            session.reset(new GameSession(*graph));
+        }
+        if (!buildReplayMaze(replay, *graph, generator)) {
+            cerr << path << ": maze cannot be rebuilt" << endl;
+            ++failed;
+            continue;
+        }
+
+        bool matches = simulateReplay(replay, *session);
+        ticks += replay.ticksPlayed;
+        if (!matches) {
+            cerr << path << ": recorded " << stateName(replay.outcome) << " after " << replay.ticksPlayed
+                << " ticks, replayed " << stateName(session->getState()) << " after " << session->getTicksPlayed() << endl;
+            ++failed;
+        }
+        else if (verbose) {
+            cout << path << ": " << stateName(replay.outcome) << ", " << replay.events.size() << " moves in "
+                << replay.ticksPlayed << " ticks" << endl;
+        }
+    }
+    double elapsed = chrono::duration<double>(chrono::steady_clock::now() - started).count();
+
+    double played = static_cast<double>(ticks) / GameSession::TICK_RATE;
+    cout << paths.size() - failed << " of " << paths.size() << " replays match; " << played << " s of play replayed in "
+        << elapsed * 1000 << " ms (" << (elapsed > 0 ? paths.size() / elapsed : 0) << " replays/s, "
+        << (elapsed > 0 ? played / elapsed : 0) << "x real time)" << endl;
+    return failed > 0 ? 1 : 0;
+}
@@ -0,0 +1,260 @@
+// mazesim: plays rounds with bots instead of people, to tune the difficulty levels.
+//
+//   mazesim [--mazes N] [--sizes WxH,...] [--algo NAME] [--bots NAME,...] [--seed S]
+//           [--threads T] [--move-time SECONDS] [--choice-time SECONDS]
+//
+// Every maze is played once per bot and difficulty, with the limits the game would give it
+// (calibrateRound() on its solution length), so N mazes are N x bots x 3 rounds. Bots press
+// keys at human-like intervals (see BotTiming) and rounds skip from key press to key press, so
+// a round costs a few microseconds. Maze i is built from deriveSeed(S, i) and its rounds are
+// timed from seeds derived from that, so results do not depend on the thread count.
+//
+// For each size, bot and difficulty it prints the share of rounds won, lost on time and lost
+// on undos, and percentiles of the time taken by the rounds that were won.
+#include "../MazeCore/Bot.h"
+#include "../MazeCore/GameSession.h"
+#include "../MazeCore/Graph.h"
+#include "../MazeCore/MazeGenerator.h"
+#include "../MazeCore/Rng.h"
+#include "../MazeCore/Solver.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+
+using namespace std;
+
+struct MazeSize {
+    int width, height;
+};
+
+struct Options {
+    int mazes = 1000;
+    vector<MazeSize> sizes = { { 20, 10 } };
+    Algorithm algorithm = Algorithm::Prim;
+    vector<BotKind> bots = { BotKind::Random, BotKind::WallFollower, BotKind::Explorer };
+    uint64_t seed = 0;
+    bool seedGiven = false;
+    int threads = 0;
+    BotTiming timing;
+};
+
+// Results of one bot at one difficulty.
+struct RoundStats {
+    uint64_t rounds = 0;
+    uint64_t outOfTime = 0;
+    uint64_t outOfMoves = 0;
+    vector<int64_t> wonTicks;  // how long each won round took
+
+    void merge(RoundStats& other) {
+        rounds += other.rounds;
+        outOfTime += other.outOfTime;
+        outOfMoves += other.outOfMoves;
+        wonTicks.insert(wonTicks.end(), other.wonTicks.begin(), other.wonTicks.end());
+    }
+};
+
+static void printUsage() {
+    cerr << "usage: mazesim [--mazes N] [--sizes WxH,...] [--algo NAME] [--bots NAME,...] [--seed S]\n"
+            "               [--threads T] [--move-time SECONDS] [--choice-time SECONDS]\n"
+            "bots:";
+    for (int i = 0; i < BOT_KIND_COUNT; ++i) {
+        cerr << " " << botName(static_cast<BotKind>(i));
+    }
+    cerr << endl;
+}
+
+static vector<string> splitList(const string& list) {
+    vector<string> items;
+    stringstream stream(list);
+    string item;
+    while (getline(stream, item, ',')) {
+        items.push_back(item);
+    }
+    return items;
+}
+
+static bool parseOptions(int argc, char* argv[], Options& options) {
+    for (int i = 1; i < argc; ++i) {
+        string arg = argv[i];
+        if (i + 1 >= argc) {
+            cerr << "missing value for " << arg << endl;
+            return false;
+        }
+        string value = argv[++i];
+
+        if (arg == "--mazes") options.mazes = stoi(value);
+        else if (arg == "--sizes") {
+            options.sizes.clear();
+            for (const string& size : splitList(value)) {
+                size_t x = size.find('x');
+                int width = stoi(size.substr(0, x));
+                int height = x == string::npos ? width : stoi(size.substr(x + 1));
+                if (width < 2 || height < 2) {
+                    cerr << "maze sizes must be at least 2x2" << endl;
+                    return false;
+                }
+                options.sizes.push_back({ width, height });
+            }
+        }
+        else if (arg == "--algo") {
+            if (!parseAlgorithm(value, options.algorithm)) {
+                cerr << "unknown algorithm '" << value << "'" << endl;
+                return false;
+            }
+        }
+        else if (arg == "--bots") {
+            options.bots.clear();
+            for (const string& name : splitList(value)) {
+                BotKind kind;
+                if (!parseBot(name, kind)) {
+                    cerr << "unknown bot '" << name << "'" << endl;
+                    return false;
+                }
+                options.bots.push_back(kind);
+            }
+        }
+        else if (arg == "--seed") { options.seed = stoull(value, nullptr, 0); options.seedGiven = true; }
+        else if (arg == "--threads") options.threads = stoi(value);
+        else if (arg == "--move-time") options.timing.secondsPerMove = stof(value);
+        else if (arg == "--choice-time") options.timing.secondsPerChoice = stof(value);
+        else {
+            cerr << "unknown option " << arg << endl;
+            return false;
+        }
+    }
+
+    if (options.mazes < 1 || options.sizes.empty() || options.bots.empty()) {
+        cerr << "need at least one maze, size and bot" << endl;
+        return false;
+    }
+    return true;
+}
+
+// The value below which share of the sorted values fall, in seconds.
+static double percentileSeconds(const vector<int64_t>& sorted, double share) {
+    size_t index = min(sorted.size() - 1, static_cast<size_t>(share * sorted.size()));
+    return static_cast<double>(sorted[index]) / GameSession::TICK_RATE;
+}
+
+static string percent(uint64_t count, uint64_t total) {
+    stringstream text;
+    text << fixed << setprecision(1) << 100.0 * count / total << "%";
+    return text.str();
+}
+
+int main(int argc, char* argv[]) {
+    Options options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage();
+        return 1;
+    }
+    if (!options.seedGiven) {
+        options.seed = (static_cast<uint64_t>(random_device{}()) << 32) ^ random_device{}();
+    }
+
+    int threadCount = options.threads > 0 ? options.threads : static_cast<int>(thread::hardware_concurrency());
+    threadCount = max(1, min(threadCount, options.mazes));
+    size_t configs = options.bots.size() * DIFFICULTY_COUNT;
+    uint64_t totalRounds = 0;
+
+    auto start = chrono::steady_clock::now();
+    for (const MazeSize& size : options.sizes) {
+        // Workers pull maze indices from a shared counter and keep their own tallies, merged at the end.
+        atomic<int> nextMaze{ 0 };
+        atomic<uint64_t> solutionMoves{ 0 };
+        vector<RoundStats> stats(configs);
+        mutex statsMutex;
+
+        auto worker = [&]() {
+            Graph graph(size.width, size.height);
+            unique_ptr<MazeGenerator> generator = makeGenerator(options.algorithm, graph, 0);
+            Solver solver(graph);
+            GameSession session(graph);
+            vector<unique_ptr<Bot>> bots;
+            for (BotKind kind : options.bots) {
+                bots.push_back(makeBot(kind));
+            }
+            vector<RoundStats> local(configs);
+            uint64_t localMoves = 0;
+
+            for (int index = nextMaze++; index < options.mazes; index = nextMaze++) {
+                uint64_t seed = deriveSeed(options.seed, index);
+                generator->reset(seed);
+                while (generator->step()) {
+                }
+                solver.computeDistances(graph.getNode(size.width - 1, size.height - 1));
+                uint32_t solutionLength = solver.distanceTo(graph.getNode(0, 0));
+                localMoves += solutionLength;
+
+                for (int difficulty = 0; difficulty < DIFFICULTY_COUNT; ++difficulty) {
+                    float timeLimit;
+                    int undos;
+                    calibrateRound(DIFFICULTY_LEVELS[difficulty], solutionLength, timeLimit, undos);
+                    for (size_t bot = 0; bot < bots.size(); ++bot) {
+                        size_t config = bot * DIFFICULTY_COUNT + difficulty;
+                        Rng rng(deriveSeed(seed, config));
+                        session.start(timeLimit, undos);
+                        SessionState result = playRound(session, graph, *bots[bot], rng, options.timing);
+
+                        RoundStats& round = local[config];
+                        ++round.rounds;
+                        if (result == SessionState::Won) round.wonTicks.push_back(session.getTicksPlayed());
+                        else if (result == SessionState::OutOfTime) ++round.outOfTime;
+                        else ++round.outOfMoves;
+                    }
+                }
+            }
+
+            lock_guard<mutex> lock(statsMutex);
+            for (size_t config = 0; config < configs; ++config) {
+                stats[config].merge(local[config]);
+            }
+            solutionMoves += localMoves;
+        };
+
+        vector<thread> workers;
+        for (int i = 0; i < threadCount; ++i) {
+            workers.emplace_back(worker);
+        }
+        for (thread& t : workers) {
+            t.join();
+        }
+
+        cout << size.width << "x" << size.height << " " << algorithmName(options.algorithm) << ", " << options.mazes
+            << " mazes, solution " << fixed << setprecision(1) << static_cast<double>(solutionMoves) / options.mazes
+            << " moves on average" << endl;
+        cout << "  " << left << setw(10) << "bot" << setw(11) << "difficulty" << right << setw(8) << "won"
+            << setw(9) << "no time" << setw(9) << "no undo" << "   won in p10 / p50 / p90 s" << endl;
+        for (size_t bot = 0; bot < options.bots.size(); ++bot) {
+            for (int difficulty = 0; difficulty < DIFFICULTY_COUNT; ++difficulty) {
+                RoundStats& round = stats[bot * DIFFICULTY_COUNT + difficulty];
+                totalRounds += round.rounds;
+                cout << "  " << left << setw(10) << botName(options.bots[bot]) << setw(11) << DIFFICULTY_LEVELS[difficulty].name
+                    << right << setw(8) << percent(round.wonTicks.size(), round.rounds) << setw(9) << percent(round.outOfTime, round.rounds)
+                    << setw(9) << percent(round.outOfMoves, round.rounds);
+                if (!round.wonTicks.empty()) {
+                    sort(round.wonTicks.begin(), round.wonTicks.end());
+                    cout << "   " << percentileSeconds(round.wonTicks, 0.1) << " / " << percentileSeconds(round.wonTicks, 0.5)
+                        << " / " << percentileSeconds(round.wonTicks, 0.9);
+                }
+                cout << endl;
+            }
+        }
+    }
+    double seconds = chrono::duration<double>(chrono::steady_clock::now() - start).count();
+
+    cout << totalRounds << " rounds (seed " << options.seed << ") on " << threadCount << " threads in "
+        << setprecision(2) << seconds << " s: " << setprecision(0) << totalRounds / seconds << " rounds/s" << endl;
+    return 0;
+}